@@ -14,7 +14,16 @@ workspace "SudokuGuider"
   platforms { "Static" , "DLL" }
   --platforms { "Static" }
   warnings "Extra"
-  disablewarnings { "4100" } -- unused parameter value (input to function)
+
+  filter { "toolset:msc*" }
+    disablewarnings { "4100" } -- unused parameter value (input to function)
+
+  -- linux, "premake5 gmake2" [see premake_gmake2.sh]
+  filter { "system:linux" }
+    links { "pthread" }
+
+  filter { "system:linux", "platforms:DLL" }
+    pic "On"
 
   -- setup the different build configurations
   filter { "platforms:Static" }
@@ -0,0 +1,4 @@
+#!/bin/sh
+echo "Launching premake gmake2"
+premake5 gmake2
+make -C ./_local -j"$(nproc)" config=final_static
@@ -0,0 +1,93 @@
+#include <Core/CpuFeatures.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace ddahlkvist
+{
+	namespace
+	{
+		struct CpuidRegisters
+		{
+			u32 eax = 0;
+			u32 ebx = 0;
+			u32 ecx = 0;
+			u32 edx = 0;
+		};
+
+		CpuidRegisters cpuid(u32 leaf, u32 subleaf) {
+			CpuidRegisters r;
+#if defined(_MSC_VER)
+			int regs[4];
+			__cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+			r.eax = static_cast<unsigned int>(regs[0]);
+			r.ebx = static_cast<unsigned int>(regs[1]);
+			r.ecx = static_cast<unsigned int>(regs[2]);
+			r.edx = static_cast<unsigned int>(regs[3]);
+#else
+			unsigned int eax, ebx, ecx, edx;
+			__cpuid_count(leaf, subleaf, eax, ebx, ecx, edx);
+			r.eax = eax;
+			r.ebx = ebx;
+			r.ecx = ecx;
+			r.edx = edx;
+#endif
+			return r;
+		}
+
+		// XCR0, which register states the os saves on a context switch
+		u64 enabledRegisterStates() {
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			unsigned int eax, edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (static_cast<u64>(edx) << 32) | eax;
+#endif
+		}
+
+		bool hasBit(u32 reg, u32 bit) {
+			return (reg >> bit) & 1u;
+		}
+
+		CpuFeatures detect() {
+			CpuFeatures f;
+
+			const CpuidRegisters leaf0 = cpuid(0, 0);
+			const u32 maxLeaf = leaf0.eax;
+			if (maxLeaf < 1)
+				return f;
+
+			const CpuidRegisters leaf1 = cpuid(1, 0);
+			f.popcnt = hasBit(leaf1.ecx, 23);
+
+			const bool isAmd = leaf0.ebx == 0x68747541 && leaf0.edx == 0x69746E65 && leaf0.ecx == 0x444D4163; // "AuthenticAMD"
+			const u32 baseFamily = (leaf1.eax >> 8) & 0xF;
+			const u32 family = baseFamily == 0xF ? baseFamily + ((leaf1.eax >> 20) & 0xFF) : baseFamily;
+
+			const bool osSavesYmm = hasBit(leaf1.ecx, 27) && (enabledRegisterStates() & 0x06) == 0x06; // osxsave, sse + avx state
+			const bool osSavesZmm = osSavesYmm && (enabledRegisterStates() & 0xE0) == 0xE0; // opmask + upper zmm state
+
+			if (maxLeaf < 7)
+				return f;
+
+			const CpuidRegisters leaf7 = cpuid(7, 0);
+			f.bmi1 = hasBit(leaf7.ebx, 3);
+			f.bmi2 = hasBit(leaf7.ebx, 8);
+			f.avx2 = osSavesYmm && hasBit(leaf7.ebx, 5);
+			f.avx512f = osSavesZmm && hasBit(leaf7.ebx, 16);
+			f.avx512bw = osSavesZmm && hasBit(leaf7.ebx, 30);
+			f.avx512vl = osSavesZmm && hasBit(leaf7.ebx, 31);
+			f.fastPdep = f.bmi2 && !(isAmd && family < 0x19); // 0x19 --> zen3
+			return f;
+		}
+	}
+
+	const CpuFeatures& cpuFeatures() {
+		static const CpuFeatures features = detect();
+		return features;
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <bit>
+#include <type_traits>
+
+#include <Core/Types.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ddahlkvist
+{
+	// thin wrappers so the bit twiddling compiles to one instruction on both MSVC and GCC/Clang
+	// popcnt is not part of the baseline build, the hot BitBoard counts pick it at runtime instead [SudokuLib/BitKernels.h]
+
+	namespace detail
+	{
+		constexpr u32 popCount(u64 word) {
+#if defined(_MSC_VER) || defined(__POPCNT__)
+			return static_cast<u32>(std::popcount(word)); // msvc checks the cpu for popcnt
+#else
+			// branch free, gcc/clang without -mpopcnt would call into the runtime library
+			word = word - ((word >> 1) & 0x5555555555555555ULL);
+			word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+			word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+			return static_cast<u32>((word * 0x0101010101010101ULL) >> 56);
+#endif
+		}
+	}
+
+	inline u32 popCount64(u64 word) {
+		return detail::popCount(word);
+	}
+
+	inline u32 popCount32(unsigned int word) {
+		return detail::popCount(word);
+	}
+
+	inline u32 popCount16(u16 word) {
+		return detail::popCount(word);
+	}
+
+	// index of the lowest set bit, word must not be 0
+	constexpr u32 trailingZeros64(u64 word) {
+		if (std::is_constant_evaluated())
+			return static_cast<u32>(std::countr_zero(word));
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return static_cast<u32>(index);
+#else
+		return static_cast<u32>(__builtin_ctzll(word));
+#endif
+	}
+
+	// same contract as _BitScanForward64, returns false and leaves outIndex untouched if word is 0
+	inline bool bitScanForward64(u32& outIndex, u64 word) {
+		if (word == 0)
+			return false;
+		outIndex = trailingZeros64(word);
+		return true;
+	}
+
+	// blsr with bmi1
+	constexpr u64 clearLowestSetBit(u64 word) {
+		return word & (word - 1);
+	}
+}
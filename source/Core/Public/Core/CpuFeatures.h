@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Core/core_module.h>
+#include <Core/Types.h>
+
+namespace ddahlkvist
+{
+	// instruction set extensions of the cpu we are running on, avx/avx-512 are only reported if the os also saves the wider registers
+	struct CpuFeatures
+	{
+		bool popcnt = false;
+		bool bmi1 = false;
+		bool bmi2 = false;
+		bool avx2 = false;
+		bool avx512f = false;
+		bool avx512bw = false;
+		bool avx512vl = false;
+
+		bool fastPdep = false; // pdep/pext are microcoded on amd before zen3, bmi2 alone does not make them worth using
+	};
+
+	// detected once, on first use
+	CORE_PUBLIC const CpuFeatures& cpuFeatures();
+}
@@ -1,55 +1,72 @@
 #pragma once
 
-#include <functional>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
 
 namespace ddahlkvist
 {
-	using u8 = unsigned char;
-	using u16 = unsigned short;
-	using u32 = unsigned long;
-	using u64 = unsigned long long;
+	// fixed width on every target, long is 64 bits on LP64 linux
+	using u8 = std::uint8_t;
+	using u16 = std::uint16_t;
+	using u32 = std::uint32_t;
+	using u64 = std::uint64_t;
 	
-	using s8 = signed char;
-	using s16 = signed short;
-	using s32 = signed long;
-	using s64 = signed long long;
+	using s8 = std::int8_t;
+	using s16 = std::int16_t;
+	using s32 = std::int32_t;
+	using s64 = std::int64_t;
+
+	static_assert(sizeof(u32) == 4 && sizeof(s32) == 4);
+	static_assert(sizeof(u64) == 8 && sizeof(s64) == 8);
 	
 	using uint = u32;
 	using usize = u64;
 	using uptr = u64;
 
-	using BitAction = std::function<void(u32 bitIndex)>;
-
+	// range over the indices of the set bits of a word, lowest first. runs once per set bit [trailing zero count + clear lowest]
+	// for (u32 bitIndex : SetBits(word)) { ... }
 	template <typename T>
-	constexpr inline void foreachSetBit(const T* __restrict source, BitAction action) {
-		T word = source[0];
+	class SetBits
+	{
+		static_assert(std::is_unsigned_v<T>, "SetBits needs an unsigned word");
+
+	public:
+		struct Iterator
+		{
+			T word;
+
+			constexpr u32 operator*() const { return static_cast<u32>(std::countr_zero(word)); }
+			constexpr Iterator& operator++() { word = static_cast<T>(word & (word - 1u)); return *this; }
+			constexpr bool operator!=(const Iterator& other) const { return word != other.word; }
+		};
 
-		for (u32 i = 0u; word != 0u; ++i) {
-			const bool smallestBitIsSet = word & T(1u);
-			if (smallestBitIsSet) {
-				action(i);
-			}
+		constexpr explicit SetBits(T word) : _word(word) {}
 
-			word >>= 1u;
-		}
+		constexpr Iterator begin() const { return Iterator{ _word }; }
+		constexpr Iterator end() const { return Iterator{ T(0u) }; }
+
+	private:
+		T _word;
+	};
+
+	// action is any callable taking the bit index, it is inlined at the call site [no std::function, nothing to allocate]
+	template <typename T, typename BitAction>
+	constexpr inline void foreachSetBit(const T* __restrict source, BitAction&& action) {
+		for (u32 bitIndex : SetBits<T>(source[0]))
+			action(bitIndex);
 	}
 
 	template <typename T>
 	constexpr inline u8 fillSetBits(const T* __restrict source, u8* __restrict target) {
-		T word = source[0];
 		u8* dest = target;
-
-		for (u8 i = 0u; word != 0u; ++i) {
-			*dest = i;
-			dest += word & T(1u);
-			word >>= 1u;
-		}
-
+		for (u32 bitIndex : SetBits<T>(source[0]))
+			*dest++ = static_cast<u8>(bitIndex);
 		return static_cast<u8>(dest - target);
 	}
 
 	template <typename T>
-	bool testBit(const T data, u32 bit) {
+	constexpr bool testBit(const T data, u32 bit) {
 		const T flag = 1ULL << bit;
 		const bool isTrue = data & flag;
 		return isTrue;
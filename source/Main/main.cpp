@@ -1,4 +1,5 @@
 #include <assert.h>  
+#include <algorithm>
 #include <functional>
 #include <iostream>
 
@@ -7,31 +8,13 @@
 #include <SudokuLib/SudokuTypes.h>
 #include <SudokuLib/SudokuAlgorithm.h>
 #include <SudokuLib/SudokuPrinter.h>
+#include <SudokuLib/SudokuSolver.h>
+#include <SudokuLib/SudokuGenerator.h>
+#include <SudokuLib/PuzzleReader.h>
 
 namespace ddahlkvist
 {
-	bool runTechniques(Board& b, Result& result) {
-		SudokuContext context = buildContext(b, result);
-
-		if (context.Unsolved == BitBoard{})
-			return true;
-
-		auto&& techniques = techniques::allTechniques();
-		for (auto i = 0ULL, end = techniques.size(); i < end; ++i) {
-			techniques::TechniqueFunction& technique = techniques[i];
-			if (technique(context))
-				return true;
-		}
-		return false;
-	}
-
-	bool solveBoard(Board& b, Result& r)	{
-		// do an early iteration to fill candidates and remove the known nodes (from neighbouring solved nodes)
-		{
-			SudokuContext context = buildContext(b, r);
-			techniques::fillUnsolvedWithNonNaiveCandidates(context);
-		}
-
+	bool benchmarkBoard(Board& b, Result& r)	{
 		// let each board be solved 100 times to make sure we have more performance data
 #ifdef DD_FINAL
 		const u32 IterationCount = 100;
@@ -46,36 +29,14 @@ namespace ddahlkvist
 		{
 			Board localBoard = b;
 			Result localResult = r;
-			SolveLedger& ledger = localResult.ledger;
 
-			u32 iteration = 0;
-
-			bool iterateAgain = true;
-			while (iterateAgain && iteration < ledger.MaxEntries) {
-#ifdef DD_DEBUG
-				localBoard.updateDebugPretty();
-#endif
-				localResult.reset();
-				if (runTechniques(localBoard, localResult)) {
-					ledger.numNodesChangedInIteration[iteration] = static_cast<u8>(localResult.size());
-					ledger.techniqueUsedInIteration[iteration] = localResult.Technique;
-				}
-				iteration++;
-				iterateAgain = localResult.size() != 0;
-			}
-
-			u32 postNumSolved = 0;
-			for (Node& n : localBoard.Nodes)
-			{
-				if (n.isSolved())
-					postNumSolved++;
-			}
+			const bool solved = solveBoard(localBoard, localResult);
 
 			if (i == LastIteration)
 			{
-				isSolved = postNumSolved == BoardSize;
+				isSolved = solved;
 				b = localBoard;
-				r = localResult;			
+				r = localResult;
 			}
 		}
 
@@ -83,7 +44,8 @@ namespace ddahlkvist
 	}
 }
 
-int main()
+// usage: SudokuSolver [puzzleFile], one 81 character puzzle per line, the example boards are solved when no file is given
+int main(int argc, char** argv)
 {
 #ifdef DD_DEBUG
 	constexpr bool PrintVerbose = true;
@@ -96,8 +58,18 @@ int main()
 	using namespace std;
 	using namespace ddahlkvist;
 
-	Board boards[1000];
-	const u32 numBoards = FillBoards(boards, GetRawBoards());
+	MappedPuzzleFile puzzleFile(argc > 1 ? argv[1] : "");
+	if (argc > 1 && !puzzleFile.isOpen()) {
+		printf("Unable to open puzzle file: %s\n", argv[1]);
+		return 1;
+	}
+
+	PuzzleTextReader reader = argc > 1 ? puzzleFile.reader() : PuzzleTextReader(ExampleBoards, sizeof(ExampleBoards) - 1);
+
+	// boards are streamed through a fixed size chunk so the number of puzzles in the file is not limited by memory
+	constexpr u32 ChunkSize = 4096;
+	std::vector<Board> boards(ChunkSize);
+	std::vector<Board> scratchBoards(PrintVerbose || StopOnFirstUnsolved ? 0 : ChunkSize);
 
 	// work on one specfic board
 	//{
@@ -124,33 +96,75 @@ int main()
 	// run all
 	u32 i = 0;	
 	u32 solvedCount = 0;
-	for (; i < numBoards; ++i) {
-		Board& board = boards[i];
-		Result outcome;
-
-		bool solved = solveBoard(board, outcome);
-		solvedCount += solved;
-		
-		if constexpr (PrintVerbose)
+	bool stopped = false;
+	while (!stopped) {
+		const u32 numBoards = reader.read(boards);
+		if (numBoards == 0)
+			break;
+
+		if constexpr (PrintVerbose || StopOnFirstUnsolved)
 		{
-			printSudokuBoard(board);
-			printCandidateOutput(Techniques::NakedPair, outcome.ledger);
-		
-			if (solved)
-				validateSolvedCorectly(board);
-			else
-				validateNoDuplicates(board); 
-			
-			cout << "BoardIndex: " << i << "\t\t" << (solved ? "solved" : "unsolved") << endl;
+			for (u32 j = 0; j < numBoards; ++j, ++i) {
+				Board& board = boards[j];
+				Result outcome;
+
+				bool solved = benchmarkBoard(board, outcome);
+				solvedCount += solved;
+
+				if constexpr (PrintVerbose)
+				{
+					printSudokuBoard(board);
+					printCandidateOutput(Techniques::NakedPair, outcome.ledger);
+
+					if (solved)
+						validateSolvedCorectly(board);
+					else
+						validateNoDuplicates(board); 
+
+					cout << "BoardIndex: " << i << "\t\t" << (solved ? "solved" : "unsolved") << endl;
+				}
+
+				if (StopOnFirstUnsolved && !solved) {
+					stopped = true;
+					break;
+				}
+			}
 		}
+		else
+		{
+			// solve all boards in parallel, repeated to make sure we have more performance data
+#ifdef DD_FINAL
+			const u32 BatchIterationCount = 100;
+#else
+			const u32 BatchIterationCount = 1;
+#endif
+			const std::span<Board> batch(scratchBoards.data(), numBoards);
+			BatchOutcome outcome;
+			for (u32 iteration = 0; iteration < BatchIterationCount; ++iteration) {
+				std::copy(boards.begin(), boards.begin() + numBoards, batch.begin());
+				outcome = solveBatch(batch);
+			}
 
-		if constexpr (StopOnFirstUnsolved && !solved)
-			break;
+			solvedCount += outcome.numSolved;
+			i += outcome.numBoards;
+		}
 	}
 
 	cout << "-------------------" << endl;
 	cout << "DONE!!" << endl;
 	printf("Execution Finished: Solved=%u/%u\n", solvedCount, i);
 
+	// generate minimal puzzles to measure generator throughput
+	{
+#ifdef DD_FINAL
+		const u32 NumGeneratedPuzzles = 1000;
+#else
+		const u32 NumGeneratedPuzzles = 10;
+#endif
+		std::vector<Board> generated(NumGeneratedPuzzles);
+		const GeneratorStats stats = generatePuzzles(generated);
+		printf("Generator Finished: Generated=%u/%u in %.2fs (%.1f puzzles/s)\n", stats.numGenerated, NumGeneratedPuzzles, stats.seconds, stats.puzzlesPerSecond);
+	}
+
 	return 0;
 }
@@ -2,13 +2,27 @@
 
 #include <Core/Types.h>
 #include <assert.h>  
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <functional>
+#include <mutex>
+#include <set>
 
 #include <Core/Types.h>
+#include <Core/BitOps.h>
 #include <SudokuLib/SudokuTypes.h>
 #include <SudokuLib/SudokuAlgorithm.h>
+#include <SudokuLib/SudokuSolver.h>
+#include <SudokuLib/SudokuGenerator.h>
+#include <SudokuLib/SudokuRating.h>
+#include <SudokuLib/PuzzleReader.h>
 #include <BoardUtils.h>
+#include <BitKernels.h>
+#include <CandidateState.h>
+#include <SubsetEngine.h>
+#include <FishEngine.h>
+#include <WorkStealing.h>
 
 namespace ddahlkvist
 {
@@ -73,6 +87,95 @@ namespace ddahlkvist
 				EXPECT_TRUE(my.Nodes[i] == innerValue);
 			}
 		}
+
+		const BoardText text(my);
+		EXPECT_EQ(memcmp(text.raw, ExampleBoardRaw, BoardSize), 0);
+		EXPECT_EQ(text.pretty[2], '5');
+	}
+
+	TEST_F(SudokuLibFixture, validateParseBoardMasks)
+	{
+		// every empty marker and a digit in the last node, which is classified outside the vector loads
+		char raw[BoardSize + 1];
+		memcpy(raw, ExampleBoardRaw, BoardSize + 1);
+		raw[0] = '0';
+		raw[1] = 'x';
+		raw[3] = ' ';
+		raw[80] = '9';
+
+		ParsedBoardMasks masks;
+		EXPECT_TRUE(parseBoardMasks(raw, masks));
+		EXPECT_FALSE(masks.malformed.notEmpty());
+
+		for (uint i = 0; i < BoardSize; ++i) {
+			const bool isDigit = raw[i] >= '1' && raw[i] <= '9';
+			EXPECT_EQ(masks.solved.test(i), isDigit);
+			for (uint d = 0; d < 9; ++d)
+				EXPECT_EQ(masks.values[d].test(i), raw[i] == static_cast<char>('1' + d));
+		}
+
+		Board parsed;
+		EXPECT_TRUE(Board::tryFromString(raw, parsed));
+		EXPECT_TRUE(parsed.Nodes[80] == 9);
+		EXPECT_TRUE(parsed == Board::fromString(raw));
+
+		// the sse2 path gives the same masks as the one picked for this cpu
+		{
+			const BitKernels* active = ActiveBitKernels;
+			ActiveBitKernels = &bitKernelsFor(BitKernelLevel::Baseline);
+			ParsedBoardMasks baselineMasks;
+			EXPECT_TRUE(parseBoardMasks(raw, baselineMasks));
+			ActiveBitKernels = active;
+
+			EXPECT_TRUE(baselineMasks.solved == masks.solved);
+			EXPECT_TRUE(baselineMasks.values == masks.values);
+		}
+
+		// malformed characters in a vector chunk and in the last node
+		raw[70] = 'a';
+		raw[80] = '\n';
+		EXPECT_FALSE(parseBoardMasks(raw, masks));
+		EXPECT_TRUE(masks.malformed.test(70));
+		EXPECT_TRUE(masks.malformed.test(80));
+		EXPECT_EQ(masks.malformed.countSetBits(), 2);
+
+		const Board untouched = parsed;
+		EXPECT_FALSE(Board::tryFromString(raw, parsed));
+		EXPECT_TRUE(parsed == untouched);
+	}
+
+	TEST_F(SudokuLibFixture, validateBitOps)
+	{
+		EXPECT_EQ(popCount64(0ULL), 0u);
+		EXPECT_EQ(popCount64(~0ULL), 64u);
+		EXPECT_EQ(popCount32(0x80000001u), 2u);
+		EXPECT_EQ(popCount16(0x03FE), 9u);
+
+		EXPECT_EQ(trailingZeros64(1ULL), 0u);
+		EXPECT_EQ(trailingZeros64(1ULL << 63), 63u);
+		EXPECT_EQ(clearLowestSetBit(0b1011000ULL), 0b1010000ULL);
+
+		static_assert([] {
+			u8 ids[16];
+			const u16 word = 0b1000000100000101;
+			return fillSetBits(&word, ids) == 4 && ids[0] == 0 && ids[1] == 2 && ids[2] == 8 && ids[3] == 15;
+		}(), "set bit iteration is usable in constant evaluation");
+
+		u32 visited = 0;
+		const u64 word = (1ULL << 63) | (1ULL << 5);
+		foreachSetBit(&word, [&visited](u32 bitIndex) { visited += bitIndex; });
+		EXPECT_EQ(visited, 68u);
+
+		u32 numBits = 0;
+		for (u32 bitIndex : SetBits<u32>(0x80000001u))
+			numBits += testBit(0x80000001u, bitIndex) ? 1 : 0;
+		EXPECT_EQ(numBits, 2u);
+
+		u32 index = 77;
+		EXPECT_FALSE(bitScanForward64(index, 0ULL));
+		EXPECT_EQ(index, 77u);
+		EXPECT_TRUE(bitScanForward64(index, 0b1000ULL));
+		EXPECT_EQ(index, 3u);
 	}
 
 	TEST_F(SudokuLibFixture, validateStaticUtilBitBoards)
@@ -213,6 +316,271 @@ namespace ddahlkvist
 		}
 	}
 
+	TEST_F(SudokuLibFixture, validateBoardTables)
+	{
+		static_assert(BoardBits::Units[18].test(0) && BoardBits::Units[26].test(80), "tables are built at compile time");
+		static_assert(BoardBits::UnitsOfNode[40].row == 4 && BoardBits::UnitsOfNode[40].column == 13 && BoardBits::UnitsOfNode[40].block == 22);
+
+		BitBoard allNodes;
+		for (const BitBoard& unit : BoardBits::Units) {
+			EXPECT_EQ(unit.countSetBits(), 9u);
+			allNodes |= unit;
+		}
+		EXPECT_TRUE(allNodes == BitBoard(BitBoard::All{}));
+
+		for (uint nodeId = 0; nodeId < BoardSize; ++nodeId) {
+			const BoardBits::NodeUnits& ids = BoardBits::UnitsOfNode[nodeId];
+			EXPECT_TRUE(BoardBits::Units[ids.row].test(nodeId));
+			EXPECT_TRUE(BoardBits::Units[ids.column].test(nodeId));
+			EXPECT_TRUE(BoardBits::Units[ids.block].test(nodeId));
+
+			const BitBoard& peers = BoardBits::Peers[nodeId];
+			EXPECT_EQ(peers.countSetBits(), 20u);
+			EXPECT_FALSE(peers.test(nodeId));
+		}
+
+		BitBoard coveredTwice;
+		for (const BoardBits::BoxLineIntersection& intersection : BoardBits::BoxLineIntersections) {
+			EXPECT_EQ(intersection.nodes.countSetBits(), 3u);
+			EXPECT_TRUE((intersection.nodes & BoardBits::BitBlock(intersection.blockId)) == intersection.nodes);
+			EXPECT_TRUE((intersection.nodes & BoardBits::Units[intersection.lineUnit]) == intersection.nodes);
+			coveredTwice ^= intersection.nodes;
+		}
+		// every node is in exactly one row segment and one column segment
+		EXPECT_FALSE(coveredTwice.notEmpty());
+
+		u8 blockId = 0;
+		EXPECT_TRUE(BoardBits::sharesBlock(blockId, BoardBits::BoxLineIntersections[53].nodes));
+		EXPECT_EQ(blockId, 8u);
+		EXPECT_FALSE(BoardBits::sharesBlock(blockId, BoardBits::BitRow(0)));
+	}
+
+	TEST_F(SudokuLibFixture, validateLockedCandidates)
+	{
+		// block 0 only has the candidate on row 0 [pointing], so node 5 in block 1 drops it
+		{
+			BitBoard candidates;
+			for (const uint nodeId : { 0, 2, 5, 13 })
+				candidates.setBit(nodeId);
+
+			const BoardBits::LockedCandidates locked = BoardBits::lockedCandidates(candidates);
+			BitBoard expected;
+			expected.setBit(5);
+			EXPECT_TRUE(locked.pointing == expected);
+			EXPECT_FALSE(locked.claiming.notEmpty());
+		}
+
+		// column 4 only has the candidate inside block 4 [claiming], so node 50 in block 4 drops it
+		{
+			BitBoard candidates;
+			for (const uint nodeId : { 31, 40, 50 })
+				candidates.setBit(nodeId);
+
+			const BoardBits::LockedCandidates locked = BoardBits::lockedCandidates(candidates);
+			BitBoard expected;
+			expected.setBit(50);
+			EXPECT_TRUE(locked.claiming == expected);
+			EXPECT_FALSE(locked.pointing.notEmpty());
+		}
+
+		// matches a brute force scan over blocks and lines
+		Board board = Board::fromString(ExampleBoardRaw);
+		Result result;
+		{
+			SudokuContext context = buildContext(board, result);
+			techniques::fillUnsolvedWithNonNaiveCandidates(context);
+		}
+		const SudokuContext context = buildContext(board, result);
+		for (uint c = 0; c < 9; ++c) {
+			const BitBoard& candidates = context.AllCandidates[c];
+			BitBoard pointing;
+			BitBoard claiming;
+			for (uint blockId = 0; blockId < 9; ++blockId) {
+				const BitBoard inBlock = candidates & BoardBits::BitBlock(blockId);
+				for (uint line = 0; line < 18; ++line) {
+					const BitBoard inLine = candidates & BoardBits::Units[line];
+					const BitBoard segment = BoardBits::BitBlock(blockId) & BoardBits::Units[line];
+					if (!segment.notEmpty() || !(inBlock & segment).notEmpty())
+						continue;
+					if ((inBlock & segment) == inBlock)
+						pointing |= inLine & segment.invert();
+					if ((inLine & segment) == inLine && inLine.countSetBits() >= 2)
+						claiming |= inBlock & segment.invert();
+				}
+			}
+			const BoardBits::LockedCandidates locked = BoardBits::lockedCandidates(candidates);
+			EXPECT_TRUE(locked.pointing == pointing);
+			EXPECT_TRUE(locked.claiming == claiming);
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateFishEngine)
+	{
+		// swordfish on rows 0, 4 and 7 [row 7 spans both words] covering columns 1, 4 and 7, node 19 on row 2 drops the candidate
+		{
+			BitBoard candidates;
+			for (const uint nodeId : { 1, 4, 19, 23, 40, 43, 64, 70 })
+				candidates.setBit(nodeId);
+
+			const fish::LineMasks lines = fish::lineMasksOf(candidates);
+			EXPECT_EQ(lines.rows[0], 0b000010010);
+			EXPECT_EQ(lines.rows[7], 0b010000010);
+			EXPECT_EQ(lines.columns[1], 0b010000101);
+			EXPECT_EQ(lines.columns[5], 0b000000100);
+
+			BitBoard expected;
+			expected.setBit(19);
+			EXPECT_TRUE(fish::fishEliminations(lines, 3, false) == expected);
+			EXPECT_FALSE(fish::fishEliminations(lines, 2, false).notEmpty());
+			EXPECT_FALSE(fish::fishEliminations(lines, 4, false).notEmpty());
+		}
+
+		// rows 0 and 3 form an x-wing on columns 0 and 6 except for the fin on node 34, only node 42 in the fin block drops the candidate
+		{
+			BitBoard candidates;
+			for (const uint nodeId : { 0, 6, 27, 33, 34, 42, 72 })
+				candidates.setBit(nodeId);
+
+			const fish::LineMasks lines = fish::lineMasksOf(candidates);
+			EXPECT_FALSE(fish::fishEliminations(lines, 2, false).notEmpty());
+
+			BitBoard expected;
+			expected.setBit(42);
+			EXPECT_TRUE(fish::fishEliminations(lines, 2, true) == expected);
+		}
+
+		// x-wing on rows 1 and 5, every other node of columns 2 and 6 drops the candidate
+		{
+			BitBoard candidates;
+			for (const uint nodeId : { 11, 15, 20, 47, 51, 69, 78 })
+				candidates.setBit(nodeId);
+
+			BitBoard expected;
+			for (const uint nodeId : { 20, 69, 78 })
+				expected.setBit(nodeId);
+			EXPECT_TRUE(fish::fishEliminations(fish::lineMasksOf(candidates), 2, false) == expected);
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateHiddenSingleKernel)
+	{
+		Board board = Board::fromString(ExampleBoardRaw);
+		Result result;
+		{
+			SudokuContext context = buildContext(board, result);
+			techniques::fillUnsolvedWithNonNaiveCandidates(context);
+		}
+		// solved nodes keep their value bits, the kernel must only look at candidates
+		EXPECT_TRUE(board.Nodes[2].isSolved());
+
+		const std::array<u16, 27> seenOnce = BoardBits::candidatesSeenOncePerUnit(board.Nodes);
+		for (uint unitId = 0; unitId < 27; ++unitId) {
+			u16 expected = 0;
+			for (uint c = 0; c < 9; ++c) {
+				uint count = 0;
+				BoardBits::Units[unitId].foreachSetBit([&](u32 nodeId) {
+					count += (board.Nodes[nodeId].getCandidates() & AllCandidatesArray[c]) ? 1 : 0;
+				});
+				if (count == 1)
+					expected |= AllCandidatesArray[c];
+			}
+			EXPECT_EQ(seenOnce[unitId], expected);
+		}
+
+		// every hit is solved with the value that was unique in one of its units
+		const Board before = board;
+		result.reset();
+		SudokuContext context = buildContext(board, result);
+		EXPECT_TRUE(techniques::removeHiddenSingle(context));
+		for (uint i = 0; i < result.size(); ++i) {
+			const u8 nodeId = result.fetch(i).index;
+			const BoardBits::NodeUnits& units = BoardBits::UnitsOfNode[nodeId];
+			const u16 value = static_cast<u16>(1u << board.Nodes[nodeId].getValue());
+			EXPECT_TRUE(board.Nodes[nodeId].isSolved());
+			EXPECT_TRUE(before.Nodes[nodeId].getCandidates() & value);
+			EXPECT_TRUE((seenOnce[units.row] | seenOnce[units.column] | seenOnce[units.block]) & value);
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateBitKernelLevels)
+	{
+		EXPECT_TRUE(isSupported(BitKernelLevel::Baseline));
+		EXPECT_TRUE(isSupported(bitKernels().level));
+
+		// random boards with a varying number of nodes, every supported level has to agree with the baseline kernels
+		u64 state = 0x9E3779B97F4A7C15ULL;
+		auto randomBoard = [&state](u32 density) {
+			BitBoard b;
+			for (uint i = 0; i < BoardSize; ++i) {
+				state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+				if ((state >> 33) % 16 < density)
+					b.setBit(i);
+			}
+			return b;
+		};
+
+		const BitKernels& baseline = bitKernelsFor(BitKernelLevel::Baseline);
+
+		// the dispatched BitBoard::fillSetBits and the inline foreachSetBit visit the same nodes in the same order
+		for (u32 round = 0; round < 64; ++round) {
+			const BitBoard b = randomBoard(round % 17);
+			u8 expectedIds[BoardSize];
+			const u8 numExpected = b.fillSetBitsPortable(expectedIds);
+			EXPECT_EQ(numExpected, b.countSetBits());
+			EXPECT_EQ(numExpected, b.countSetBitsPortable());
+
+			u8 nodeIds[BoardSize];
+			ASSERT_EQ(b.fillSetBits(nodeIds), numExpected);
+			EXPECT_TRUE(std::equal(nodeIds, nodeIds + numExpected, expectedIds));
+
+			u8 numVisited = 0;
+			b.foreachSetBit([&](u32 nodeId) {
+				EXPECT_EQ(nodeId, expectedIds[numVisited]);
+				++numVisited;
+			});
+			EXPECT_EQ(numVisited, numExpected);
+		}
+
+		for (u32 l = 1; l < static_cast<u32>(BitKernelLevel::Count); ++l) {
+			const BitKernelLevel level = static_cast<BitKernelLevel>(l);
+			if (!isSupported(level))
+				continue;
+
+			const BitKernels& kernels = bitKernelsFor(level);
+			for (u32 round = 0; round < 200; ++round) {
+				const BitBoard mask = randomBoard(round % 17);
+
+				u8 expectedIds[BoardSize + 1];
+				u8 nodeIds[BoardSize + 1];
+				const u8 numExpected = baseline.fillSetBits(mask, expectedIds);
+				ASSERT_EQ(kernels.fillSetBits(mask, nodeIds), numExpected);
+				EXPECT_TRUE(std::equal(nodeIds, nodeIds + numExpected, expectedIds));
+				EXPECT_EQ(kernels.countSetBits(mask), baseline.countSetBits(mask));
+
+				BoardBits::BitBoards9 candidates;
+				for (BitBoard& nodesWithCandidate : candidates)
+					nodesWithCandidate = randomBoard(round % 13);
+
+				BoardBits::BitBoards9 peers;
+				for (BitBoard& peersOfValue : peers)
+					peersOfValue = randomBoard(round % 11);
+				BoardBits::BitBoards9 expectedCandidates = candidates, expectedRemoved;
+				BoardBits::BitBoards9 remainingCandidates = candidates, removed;
+				const BitBoard expectedAny = baseline.removeFromCandidates(expectedCandidates, expectedRemoved, peers);
+				for (uint i = 0; i < 9; ++i)
+					EXPECT_TRUE(expectedCandidates[i] == (candidates[i] & peers[i].invert()));
+				EXPECT_TRUE(kernels.removeFromCandidates(remainingCandidates, removed, peers) == expectedAny);
+				EXPECT_TRUE(remainingCandidates == expectedCandidates);
+				EXPECT_TRUE(removed == expectedRemoved);
+
+				for (int max = 1; max < 9; ++max) {
+					for (int min = 1; min <= max; ++min)
+						EXPECT_TRUE(kernels.nodesWithCandidateCountBetweenXY(candidates, min, max) == baseline.nodesWithCandidateCountBetweenXY(candidates, min, max));
+				}
+			}
+		}
+	}
+
 	TEST_F(SudokuLibFixture, validateBoardAndBitBoardTransformations)
 	{
 		Board b = Board::fromString(ExampleBoardRaw);
@@ -300,6 +668,37 @@ namespace ddahlkvist
 				EXPECT_TRUE(board.Nodes[bitIndex].getCandidates() == ExpectedCandidates);
 				});
 		}
+		{
+			// only nodes solved since the last elimination are queued, each clears its value from its peers
+			Board board;
+			board.Nodes[0].solve(1);
+
+			Result outcome;
+			SudokuContext ctx = buildContext(board, outcome);
+			techniques::fillUnsolvedWithNonNaiveCandidates(ctx);
+			EXPECT_FALSE(ctx.PendingSolved.notEmpty());
+
+			outcome.reset();
+			EXPECT_FALSE(techniques::removeNaiveCandidates(ctx));
+
+			board.Nodes[80].solve(9);
+			BitBoard solvedNode;
+			solvedNode.setBit(80);
+			updateContext(ctx, solvedNode);
+			EXPECT_TRUE(ctx.PendingSolved == solvedNode);
+
+			outcome.reset();
+			EXPECT_TRUE(techniques::removeNaiveCandidates(ctx));
+			EXPECT_TRUE(outcome.changedNodes() == BoardBits::NeighboursForNode(80));
+			EXPECT_FALSE(ctx.PendingSolved.notEmpty());
+			BoardBits::NeighboursForNode(80).foreachSetBit([&board](u32 bitIndex) {
+				EXPECT_FALSE(board.Nodes[bitIndex].getCandidates() & Candidates::c9);
+				});
+
+			// a fresh context queues every solved node again
+			SudokuContext rebuilt = buildContext(board, outcome);
+			EXPECT_TRUE(rebuilt.PendingSolved == rebuilt.Solved);
+		}
 	}
 
 	TEST_F(SudokuLibFixture, validateSoloCandidateTechnique)
@@ -316,4 +715,699 @@ namespace ddahlkvist
 		EXPECT_TRUE(outcome.fetch(0).index == 64);
 	}
 
+	TEST_F(SudokuLibFixture, validateResultChangeLog)
+	{
+		Board board;
+		for (uint i = 0; i < BoardSize; ++i)
+			board.Nodes[i].candidatesSet(static_cast<u16>(i * 2));
+
+		Result r;
+		BitBoard affected;
+		affected.setBit(3);
+		affected.setBit(80);
+		r.storePreModification(board.Nodes, affected);
+		r.append(board.Nodes[3], 3);
+		r.append(board.Nodes[40], 40);
+		ASSERT_EQ(r.size(), 3u);
+		EXPECT_EQ(r.fetch(0).index, 3);
+		EXPECT_EQ(r.fetch(1).index, 80);
+		EXPECT_EQ(r.fetch(2).index, 40);
+		EXPECT_TRUE(r.fetch(1).prev == board.Nodes[80]);
+
+		// every node changed once fills the log exactly
+		r.storePreModification(board.Nodes, BitBoard{}.invert());
+		EXPECT_EQ(r.size(), BoardSize);
+		EXPECT_EQ(r.changedNodes().countSetBits(), BoardSize);
+
+		r.ledger.numIterations = 2;
+		r.ledger.techniqueUsedInIteration[1] = Techniques::X_Wing;
+		r.ledger.numNodesChangedInIteration[1] = 7;
+		const Result copy = r;
+		EXPECT_EQ(copy.size(), BoardSize);
+		EXPECT_EQ(copy.fetch(80).index, r.fetch(80).index);
+		EXPECT_EQ(copy.ledger.numIterations, 2u);
+		EXPECT_EQ(copy.ledger.techniqueUsedInIteration[1], Techniques::X_Wing);
+		EXPECT_EQ(copy.ledger.numNodesChangedInIteration[1], 7);
+
+		r.reset();
+		EXPECT_EQ(r.size(), 0u);
+		EXPECT_FALSE(r.changedNodes().notEmpty());
+		r.append(board.Nodes[3], 3);
+		EXPECT_EQ(r.size(), 1u);
+	}
+
+	TEST_F(SudokuLibFixture, validateSubsetEngine)
+	{
+		EXPECT_EQ(subsets::MasksWithBitCount<2>.size(), 36u);
+		EXPECT_EQ(subsets::MasksWithBitCount<3>.size(), 84u);
+		EXPECT_EQ(subsets::MasksWithBitCount<4>.size(), 126u);
+		for (uint size = subsets::MinSize; size <= subsets::MaxSize; ++size) {
+			u16 previous = 0;
+			for (const u16 mask : subsets::masksWithBitCount(size)) {
+				EXPECT_EQ(popCount16(mask), size);
+				EXPECT_GT(mask, previous);
+				previous = mask;
+			}
+		}
+
+		// row 0: naked pair {1,2} in nodes 0 and 4, hidden pair {8,9} in nodes 6 and 7, every other node has all candidates
+		Board board;
+		for (uint i = 0; i < BoardSize; ++i)
+			board.Nodes[i].candidatesSet(Candidates::All);
+		const u16 ThreeToSeven = Candidates::c3 | Candidates::c4 | Candidates::c5 | Candidates::c6 | Candidates::c7;
+		for (const uint nodeId : { 1, 2, 3, 5, 8 })
+			board.Nodes[nodeId].candidatesSet(ThreeToSeven);
+		board.Nodes[0].candidatesSet(Candidates::c1 | Candidates::c2);
+		board.Nodes[4].candidatesSet(Candidates::c1 | Candidates::c2);
+
+		const subsets::BoardCandidates candidates(board);
+		uint numNaked = 0;
+		subsets::foreachNakedSubset(candidates, 2, [&numNaked](const subsets::SubsetMatch& match) {
+			EXPECT_EQ(match.unitId, 0);
+			EXPECT_EQ(match.cells, (1u << 0) | (1u << 4));
+			EXPECT_EQ(subsets::toNodeMask(match.candidates), Candidates::c1 | Candidates::c2);
+			numNaked++;
+		});
+		EXPECT_EQ(numNaked, 1u);
+
+		uint numHidden = 0;
+		subsets::foreachHiddenSubset(candidates, 2, [&numHidden](const subsets::SubsetMatch& match) {
+			u8 nodeIds[subsets::MaxSize];
+			EXPECT_EQ(subsets::nodeIdsOf(match, nodeIds), 2);
+			EXPECT_EQ(nodeIds[0], 6);
+			EXPECT_EQ(nodeIds[1], 7);
+			EXPECT_EQ(subsets::toNodeMask(match.candidates), Candidates::c8 | Candidates::c9);
+			numHidden++;
+		});
+		EXPECT_EQ(numHidden, 1u);
+
+		Result result;
+		SudokuContext context = buildContext(board, result);
+		EXPECT_TRUE(techniques::removeNakedPair(context));
+		EXPECT_EQ(board.Nodes[6].getCandidates(), Candidates::All & ~(Candidates::c1 | Candidates::c2));
+
+		result.reset();
+		updateContext(context, BoardBits::BitRow(0));
+		EXPECT_TRUE(techniques::removeHiddenPair(context));
+		EXPECT_EQ(board.Nodes[6].getCandidates(), Candidates::c8 | Candidates::c9);
+		EXPECT_EQ(board.Nodes[7].getCandidates(), Candidates::c8 | Candidates::c9);
+
+		// row 0 with 6 unsolved nodes where every candidate is in 2-3 of them, still holds the hidden triple {1,2,3} in nodes 0-2
+		{
+			Board tight;
+			for (uint i = 0; i < BoardSize; ++i)
+				tight.Nodes[i].candidatesSet(Candidates::All);
+			const u16 rowCandidates[6] = {
+				Candidates::c1 | Candidates::c2 | Candidates::c4,
+				Candidates::c2 | Candidates::c3 | Candidates::c5,
+				Candidates::c1 | Candidates::c3 | Candidates::c6,
+				Candidates::c4 | Candidates::c5,
+				Candidates::c5 | Candidates::c6,
+				Candidates::c4 | Candidates::c6,
+			};
+			for (uint i = 0; i < 6; ++i)
+				tight.Nodes[i].candidatesSet(rowCandidates[i]);
+			for (uint i = 6; i < 9; ++i)
+				tight.Nodes[i].solve(i + 1);
+
+			uint numTriples = 0;
+			subsets::foreachHiddenSubset(subsets::BoardCandidates(tight), 3, [&numTriples](const subsets::SubsetMatch& match) {
+				if (match.unitId != 0)
+					return;
+				EXPECT_EQ(match.cells, 0b111u);
+				EXPECT_EQ(subsets::toNodeMask(match.candidates), Candidates::c1 | Candidates::c2 | Candidates::c3);
+				numTriples++;
+			});
+			EXPECT_EQ(numTriples, 1u);
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateUpdateContextMatchesRebuild)
+	{
+		Board board = Board::fromString(ExampleBoardRaw);
+		Result outcome;
+		{
+			SudokuContext initial = buildContext(board, outcome);
+			techniques::fillUnsolvedWithNonNaiveCandidates(initial);
+		}
+
+		SudokuContext context = buildContext(board, outcome);
+		outcome.reset();
+		EXPECT_TRUE(techniques::removeNaiveCandidates(context) || techniques::removeNakedSingle(context) || techniques::removeHiddenSingle(context));
+		EXPECT_TRUE(outcome.changedNodes().notEmpty());
+		updateContext(context, outcome.changedNodes());
+
+		Result ignored;
+		const SudokuContext rebuilt = buildContext(board, ignored);
+		EXPECT_TRUE(context.Solved == rebuilt.Solved);
+		EXPECT_TRUE(context.Unsolved == rebuilt.Unsolved);
+		for (uint i = 0; i < 9; ++i) {
+			EXPECT_TRUE(context.SolvedValues[i] == rebuilt.SolvedValues[i]);
+			EXPECT_TRUE(context.AllCandidates[i] == rebuilt.AllCandidates[i]);
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateSolveBatchMatchesSolveBoard)
+	{
+		Board expected = Board::fromString(ExampleBoardRaw);
+		Result expectedResult;
+		const bool expectedSolved = solveBoard(expected, expectedResult);
+
+		constexpr u32 NumBoards = 37;
+		std::vector<Board> boards(NumBoards, Board::fromString(ExampleBoardRaw));
+		std::vector<Result> results(NumBoards);
+
+		BatchOptions options;
+		options.numThreads = 4;
+		options.chunkSize = 1;
+		const BatchOutcome outcome = solveBatch(boards, options, results);
+
+		EXPECT_EQ(outcome.numBoards, NumBoards);
+		EXPECT_EQ(outcome.numSolved, expectedSolved ? NumBoards : 0u);
+		for (u32 i = 0; i < NumBoards; ++i) {
+			EXPECT_TRUE(boards[i] == expected);
+			EXPECT_EQ(results[i].ledger.numIterations, expectedResult.ledger.numIterations);
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateWorkStealingPool)
+	{
+		constexpr u32 NumItems = 1000;
+		std::mutex mutex;
+		std::set<std::thread::id> threads;
+
+		auto visitAll = [&]() {
+			std::vector<std::atomic<u32>> visits(NumItems);
+			runWorkStealing(NumItems, 4, 8, [&](u32 workerId, u32 index) {
+				EXPECT_LT(workerId, 4u);
+				visits[index]++;
+				std::lock_guard<std::mutex> lock(mutex);
+				threads.insert(std::this_thread::get_id());
+			});
+			for (const std::atomic<u32>& numVisits : visits)
+				EXPECT_EQ(numVisits.load(), 1u);
+		};
+
+		// the second run reuses the workers of the first one, so both runs together never see more than 4 threads
+		visitAll();
+		visitAll();
+		EXPECT_LE(threads.size(), 4u);
+
+		// a run started from inside a job still visits every index
+		std::atomic<u32> numNested = 0;
+		runWorkStealing(4, 4, 1, [&](u32, u32) {
+			runWorkStealing(10, 4, 1, [&](u32, u32) { numNested++; });
+		});
+		EXPECT_EQ(numNested.load(), 40u);
+	}
+
+	TEST_F(SudokuLibFixture, validatePackedBoardBatch)
+	{
+		const Board puzzle = Board::fromString(ExampleBoardRaw);
+		const PackedBoard packed = packBoard(puzzle);
+
+		Board unpacked;
+		EXPECT_TRUE(unpackBoard(packed, unpacked));
+		EXPECT_TRUE(unpacked == puzzle);
+		EXPECT_EQ(packed.get(2), 5);
+		EXPECT_EQ(packed.get(80), 0);
+
+		BoardBatch owned;
+		for (u32 i = 0; i < 8; ++i)
+			owned.append(puzzle);
+		EXPECT_EQ(owned.sizeInBytes(), 8 * PackedBoard::NumBytes);
+
+		// a view over the bytes of another batch reads the same boards without copying them
+		BoardBatch view;
+		EXPECT_FALSE(BoardBatch::fromBytes(owned.data(), owned.sizeInBytes() - 1, view));
+		EXPECT_TRUE(BoardBatch::fromBytes(owned.data(), owned.sizeInBytes(), view));
+		EXPECT_FALSE(view.isOwning());
+		EXPECT_EQ(view.size(), 8u);
+		EXPECT_EQ(&view[3], &owned[3]);
+
+		Board expected = puzzle;
+		Result expectedResult;
+		EXPECT_TRUE(solveBoard(expected, expectedResult));
+
+		for (SolveMode mode : { SolveMode::Explainable, SolveMode::RawThroughput }) {
+			std::vector<PackedBoard> solutions(view.size());
+			BatchOptions options;
+			options.mode = mode;
+			options.numThreads = 2;
+			options.chunkSize = 1;
+
+			const BatchOutcome outcome = solveBatch(view, solutions, options);
+			EXPECT_EQ(outcome.numSolved, 8u);
+			for (const PackedBoard& solution : solutions)
+				EXPECT_TRUE(solution == packBoard(expected));
+		}
+
+		// copies of an owning batch view their own boards, moves keep viewing the moved boards
+		{
+			BoardBatch copy;
+			{
+				const BoardBatch source = owned;
+				copy = source;
+				EXPECT_TRUE(source.isOwning());
+			}
+			EXPECT_TRUE(copy.isOwning());
+			EXPECT_NE(copy.data(), owned.data());
+			EXPECT_TRUE(copy[7] == packed);
+
+			const void* boards = copy.data();
+			const BoardBatch moved = std::move(copy);
+			EXPECT_TRUE(moved.isOwning());
+			EXPECT_EQ(moved.data(), boards);
+			EXPECT_EQ(copy.size(), 0u);
+
+			const BoardBatch viewCopy = view;
+			EXPECT_FALSE(viewCopy.isOwning());
+			EXPECT_EQ(&viewCopy[3], &owned[3]);
+		}
+
+		// nibbles above 9 are rejected before they can reach Node::solve
+		{
+			std::vector<u8> bytes(static_cast<const u8*>(owned.data()), static_cast<const u8*>(owned.data()) + owned.sizeInBytes());
+			bytes[PackedBoard::NumBytes * 5 + 3] = 0xF0;
+			BoardBatch corrupt;
+			EXPECT_FALSE(BoardBatch::fromBytes(bytes.data(), bytes.size(), corrupt));
+
+			const PackedBoard& badBoard = *reinterpret_cast<const PackedBoard*>(&bytes[PackedBoard::NumBytes * 5]);
+			EXPECT_FALSE(badBoard.isValid());
+			Board untouched = puzzle;
+			EXPECT_FALSE(unpackBoard(badBoard, untouched));
+			EXPECT_TRUE(untouched == puzzle);
+
+			// a view made straight from the span skips the check, the corrupt board is left unsolved
+			const BoardBatch unchecked(std::span<const PackedBoard>(reinterpret_cast<const PackedBoard*>(bytes.data()), 8));
+			std::vector<PackedBoard> solutions(unchecked.size());
+			const BatchOutcome outcome = solveBatch(unchecked, solutions);
+			EXPECT_EQ(outcome.numSolved, 7u);
+			EXPECT_TRUE(solutions[5] == PackedBoard{});
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateCustomTechniquePipeline)
+	{
+		using NakedSingleOnly = techniques::TechniquePipeline<techniques::removeNakedSingle>;
+		static_assert(NakedSingleOnly::Size == 1);
+
+		Board board;
+		Result outcome;
+		board.Nodes[64].candidatesSet(1 << 5);
+
+		SudokuContext context = buildContext(board, outcome);
+		EXPECT_TRUE(NakedSingleOnly::run(context));
+		EXPECT_TRUE(outcome.Technique == Techniques::NakedSingle);
+		EXPECT_TRUE(board.Nodes[64] == 5u);
+		EXPECT_EQ(techniques::allTechniques().size(), techniques::DefaultPipeline::Size);
+	}
+
+	TEST_F(SudokuLibFixture, validateSearchFallback)
+	{
+		{
+			// AI Escargot, needs guessing with the current set of techniques
+			Board board = Board::fromString("1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..");
+			Result outcome;
+			EXPECT_TRUE(solveBoard(board, outcome));
+			EXPECT_TRUE(outcome.ledger.techniqueUsedInIteration[outcome.ledger.numIterations - 1] == Techniques::Backtracking);
+
+			Result ignored;
+			const SudokuContext ctx = buildContext(board, ignored);
+			EXPECT_FALSE(BoardBits::hasContradiction(ctx));
+			EXPECT_TRUE(ctx.Unsolved == BitBoard{});
+		}
+		{
+			// empty board has plenty of solutions, search returns the first one it finds
+			Board board;
+			Result outcome;
+			EXPECT_TRUE(solveBoard(board, outcome));
+		}
+		{
+			// value 1 has no place left in the center block
+			Board board = Board::fromString("..............1.......1...........................................1.......1......");
+			const Board original = board;
+			Result outcome;
+			{
+				SudokuContext context = buildContext(board, outcome);
+				techniques::fillUnsolvedWithNonNaiveCandidates(context);
+			}
+			SudokuContext context = buildContext(board, outcome);
+			EXPECT_FALSE(searchBoard(context, &techniques::DefaultPipeline::run));
+			EXPECT_TRUE(context.Unsolved == buildContext(board, outcome).Unsolved);
+			for (uint i = 0; i < BoardSize; ++i)
+				EXPECT_TRUE(board.Nodes[i].isSolved() == original.Nodes[i].isSolved());
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateExactCoverMatchesTechniques)
+	{
+		const char* raw[] = {
+			ExampleBoardRaw,
+			"1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+		};
+
+		for (const char* data : raw) {
+			Board explainable = Board::fromString(data);
+			Board rawThroughput = Board::fromString(data);
+			Result explainableResult;
+			Result rawResult;
+
+			EXPECT_TRUE(solveBoard(explainable, explainableResult, SolveMode::Explainable));
+			EXPECT_TRUE(solveBoard(rawThroughput, rawResult, SolveMode::RawThroughput));
+			EXPECT_EQ(rawResult.ledger.numIterations, 0u);
+
+			for (uint i = 0; i < BoardSize; ++i)
+				EXPECT_EQ(explainable.Nodes[i].getValue(), rawThroughput.Nodes[i].getValue());
+		}
+
+		{
+			// two 5's in the first row
+			Board board = Board::fromString("5...5............................................................................");
+			Result outcome;
+			EXPECT_FALSE(solveBoardExactCover(board, outcome));
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateCandidateMajorState)
+	{
+		{
+			// derived per-node masks match the naive candidates of the node based solver
+			Board board = Board::fromString(ExampleBoardRaw);
+			CandidateState state;
+			EXPECT_TRUE(CandidateState::fromBoard(board, state));
+
+			Result outcome;
+			SudokuContext context = buildContext(board, outcome);
+			techniques::fillUnsolvedWithNonNaiveCandidates(context);
+			for (uint i = 0; i < BoardSize; ++i) {
+				if (!board.Nodes[i].isSolved()) {
+					EXPECT_EQ(state.candidatesOf(i), board.Nodes[i].getCandidates());
+				}
+			}
+
+			Board written;
+			state.writeToBoard(written);
+			EXPECT_TRUE(written == board);
+		}
+
+		const char* raw[] = {
+			ExampleBoardRaw,
+			"1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+		};
+
+		{
+			// singles alone get stuck, the bitboard techniques finish it without a guess and never remove the value of the solution
+			const char* stuckOnSingles = "7....9.8..3...7.5....8349...8..514...1.6....8.2....5..1....8.4......52....2.....9";
+			Board solution = Board::fromString(stuckOnSingles);
+			Result outcome;
+			EXPECT_TRUE(solveBoard(solution, outcome, SolveMode::RawThroughput));
+
+			CandidateState state;
+			EXPECT_TRUE(CandidateState::fromBoard(Board::fromString(stuckOnSingles), state));
+			EXPECT_TRUE(propagateSingles(state));
+			EXPECT_TRUE(state.unsolved().notEmpty());
+
+			while (eliminateCandidates(state)) {
+				EXPECT_TRUE(propagateSingles(state));
+				for (uint i = 0; i < BoardSize; ++i) {
+					const u32 candidateId = solution.Nodes[i].getValue() - 1u;
+					EXPECT_TRUE(state.solved[candidateId].test(i) || state.candidates[candidateId].test(i));
+				}
+			}
+
+			Board written;
+			state.writeToBoard(written);
+			EXPECT_TRUE(written == solution);
+		}
+
+		for (const char* data : raw) {
+			Board candidateMajor = Board::fromString(data);
+			Board rawThroughput = Board::fromString(data);
+			Result outcome;
+			EXPECT_TRUE(solveBoard(candidateMajor, outcome, SolveMode::CandidateMajor));
+			EXPECT_TRUE(solveBoard(rawThroughput, outcome, SolveMode::RawThroughput));
+			EXPECT_TRUE(candidateMajor == rawThroughput);
+		}
+
+		{
+			Result outcome;
+			Board conflictingGivens = Board::fromString("5...5............................................................................");
+			EXPECT_FALSE(solveBoardCandidateMajor(conflictingGivens, outcome));
+
+			// value 1 has no place left in the center block, the board is left untouched
+			Board unsolvable = Board::fromString("..............1.......1...........................................1.......1......");
+			const Board original = unsolvable;
+			EXPECT_FALSE(solveBoardCandidateMajor(unsolvable, outcome));
+			EXPECT_TRUE(unsolvable == original);
+
+			Board empty{};
+			EXPECT_TRUE(solveBoardCandidateMajor(empty, outcome));
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateCountSolutions)
+	{
+		const Board unique = Board::fromString(ExampleBoardRaw);
+		EXPECT_EQ(countSolutions(unique, 10), 1u);
+		EXPECT_TRUE(hasUniqueSolution(unique));
+
+		// the empty board stops at the limit
+		const Board empty{};
+		EXPECT_EQ(countSolutions(empty, 5), 5u);
+		EXPECT_FALSE(hasUniqueSolution(empty));
+
+		// every given of a minimal puzzle is required, removing any one of them opens up more solutions
+		const Board minimal = removeCluesMinimal(generateFullGrid(77), 78);
+		EXPECT_TRUE(hasUniqueSolution(minimal));
+		for (uint i = 0; i < BoardSize; ++i) {
+			if (!minimal.Nodes[i].isSolved())
+				continue;
+
+			Board opened = minimal;
+			opened.Nodes[i] = Node();
+			EXPECT_EQ(countSolutions(opened, 2), 2u);
+		}
+
+		const Board conflicting = Board::fromString("5...5............................................................................");
+		EXPECT_EQ(countSolutions(conflicting, 2), 0u);
+
+		// the solver must be left clean after each use
+		EXPECT_EQ(countSolutions(unique, 10), 1u);
+	}
+
+	TEST_F(SudokuLibFixture, validateGeneratePuzzles)
+	{
+		{
+			Board grid = generateFullGrid(1234);
+			Result ignored;
+			const SudokuContext ctx = buildContext(grid, ignored);
+			EXPECT_TRUE(ctx.Unsolved == BitBoard{});
+			EXPECT_FALSE(BoardBits::hasContradiction(ctx));
+
+			const Board puzzle = removeCluesMinimal(grid, 5678);
+			EXPECT_TRUE(hasUniqueSolution(puzzle));
+
+			// minimal, every remaining clue is required
+			for (uint i = 0; i < BoardSize; ++i) {
+				if (!puzzle.Nodes[i].isSolved())
+					continue;
+				Board fewerClues = puzzle;
+				fewerClues.Nodes[i] = Node();
+				EXPECT_FALSE(hasUniqueSolution(fewerClues));
+			}
+		}
+
+		{
+			constexpr u32 NumPuzzles = 8;
+			std::vector<Board> puzzles(NumPuzzles);
+			GeneratorOptions options;
+			options.seed = 42;
+			options.numThreads = 2;
+			options.maxTechnique = Techniques::HiddenSingle;
+
+			const GeneratorStats stats = generatePuzzles(puzzles, options);
+			EXPECT_EQ(stats.numGenerated, NumPuzzles);
+			EXPECT_GE(stats.numAttempts, NumPuzzles);
+
+			for (Board& puzzle : puzzles) {
+				EXPECT_TRUE(hasUniqueSolution(puzzle));
+				Result outcome;
+				EXPECT_TRUE(solveBoard(puzzle, outcome));
+				EXPECT_TRUE(isWithinDifficulty(hardestTechnique(outcome.ledger), Techniques::None, Techniques::HiddenSingle));
+			}
+		}
+
+		// the hardest technique follows difficultyRank, not the enum order
+		{
+			SolveLedger ledger;
+			ledger.numIterations = 3;
+			ledger.techniqueUsedInIteration[0] = Techniques::HiddenQuad;
+			ledger.techniqueUsedInIteration[1] = Techniques::PointingPair;
+			ledger.techniqueUsedInIteration[2] = Techniques::UniqueRectangle; // no progress, ignored
+			ledger.numNodesChangedInIteration[0] = 1;
+			ledger.numNodesChangedInIteration[1] = 1;
+			ledger.numNodesChangedInIteration[2] = 0;
+			EXPECT_TRUE(hardestTechnique(ledger) == Techniques::HiddenQuad);
+
+			ledger.techniqueUsedInIteration[1] = Techniques::Swordfish;
+			EXPECT_TRUE(hardestTechnique(ledger) == Techniques::Swordfish);
+			EXPECT_FALSE(isWithinDifficulty(Techniques::Swordfish, Techniques::None, Techniques::UniqueRectangle));
+			EXPECT_TRUE(isWithinDifficulty(Techniques::PointingPair, Techniques::HiddenSingle, Techniques::NakedPair));
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateDifficultyRating)
+	{
+		{
+			SolveLedger ledger;
+			ledger.numIterations = 3;
+			ledger.techniqueUsedInIteration[0] = Techniques::NakedSingle;
+			ledger.numNodesChangedInIteration[0] = 2;
+			ledger.techniqueUsedInIteration[1] = Techniques::X_Wing;
+			ledger.numNodesChangedInIteration[1] = 4;
+			ledger.techniqueUsedInIteration[2] = Techniques::UniqueRectangle; // no progress, ignored
+			ledger.numNodesChangedInIteration[2] = 0;
+
+			RatingWeights weights;
+			weights.perUse[static_cast<u32>(Techniques::NakedSingle)] = 1.f;
+			weights.perNode[static_cast<u32>(Techniques::NakedSingle)] = 0.5f;
+			weights.perUse[static_cast<u32>(Techniques::X_Wing)] = 10.f;
+			weights.perUse[static_cast<u32>(Techniques::UniqueRectangle)] = 100.f;
+
+			const BoardRating rating = rateLedger(ledger, true, weights);
+			EXPECT_FLOAT_EQ(rating.score, 1.f + 0.5f * 2 + 10.f);
+			EXPECT_TRUE(rating.hardest == Techniques::X_Wing);
+		}
+
+		// hardest follows difficultyRank, and the default weights never rank an easier technique above a harder one
+		{
+			SolveLedger ledger;
+			ledger.numIterations = 2;
+			ledger.techniqueUsedInIteration[0] = Techniques::NakedPair;
+			ledger.techniqueUsedInIteration[1] = Techniques::PointingPair;
+			ledger.numNodesChangedInIteration[0] = 1;
+			ledger.numNodesChangedInIteration[1] = 1;
+			EXPECT_TRUE(rateLedger(ledger, true, RatingWeights::defaults()).hardest == Techniques::NakedPair);
+
+			const RatingWeights weights = RatingWeights::defaults();
+			for (u32 a = 0; a < NumTechniques; ++a) {
+				for (u32 b = 0; b < NumTechniques; ++b) {
+					if (difficultyRank(static_cast<Techniques>(a)) < difficultyRank(static_cast<Techniques>(b))) {
+						EXPECT_LE(weights.perUse[a], weights.perUse[b]);
+					}
+				}
+			}
+		}
+
+		{
+			const Board easy = Board::fromString(ExampleBoardRaw);
+			const Board hard = Board::fromString("1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..");
+			std::vector<Board> corpus = { easy, hard, easy, hard };
+			std::vector<BoardRating> ratings(corpus.size());
+
+			RatingOptions options;
+			options.numThreads = 2;
+			options.chunkSize = 1;
+
+			RatingSummary total;
+			total.add(rateBoards(std::span<const Board>(corpus).first(2), std::span<BoardRating>(ratings).first(2), options));
+			total.add(rateBoards(std::span<const Board>(corpus).last(2), std::span<BoardRating>(ratings).last(2), options));
+
+			EXPECT_EQ(total.numRated, 4u);
+			EXPECT_EQ(total.numSolved, 4u);
+			EXPECT_GT(ratings[1].score, ratings[0].score);
+			EXPECT_FLOAT_EQ(ratings[0].score, ratings[2].score);
+			EXPECT_TRUE(ratings[1].hardest == Techniques::Backtracking);
+			EXPECT_EQ(total.numWithHardest[static_cast<u32>(Techniques::Backtracking)], 2u);
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validatePuzzleTextReader)
+	{
+		std::string text = "# comment line\n";
+		text += ExampleBoardRaw;
+		text += "\r\n";
+		text += "too short\n";
+		text += "\n";
+		text += ExampleBoardRaw;
+		text += " trailing data is ignored\n";
+		text += ExampleBoardRaw; // last line without newline
+
+		const Board expected = Board::fromString(ExampleBoardRaw);
+
+		PuzzleTextReader reader(text.data(), text.size());
+		Board boards[2];
+		EXPECT_EQ(reader.read(boards), 2u);
+		EXPECT_TRUE(boards[0] == expected);
+		EXPECT_TRUE(boards[1] == expected);
+
+		Board last;
+		EXPECT_TRUE(reader.next(last));
+		EXPECT_TRUE(last == expected);
+		EXPECT_FALSE(reader.next(last));
+		EXPECT_TRUE(reader.isDone());
+
+		const MappedPuzzleFile missing("this/file/does/not/exist.txt");
+		EXPECT_FALSE(missing.isOpen());
+	}
+
+	namespace
+	{
+		// file in the temp directory with exactly the given content, removed again when the test is done with it
+		std::filesystem::path writeTempFile(const char* name, const std::string& content) {
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file.write(content.data(), static_cast<std::streamsize>(content.size()));
+			return path;
+		}
+	}
+
+	TEST_F(SudokuLibFixture, validateMappedPuzzleFile)
+	{
+		const char* raw[] = {
+			ExampleBoardRaw,
+			"1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+			"7....9.8..3...7.5....8349...8..514...1.6....8.2....5..1....8.4......52....2.....9",
+		};
+		std::string text = "# three puzzles\n";
+		for (const char* data : raw) {
+			text += data;
+			text += "\n";
+		}
+
+		const std::filesystem::path path = writeTempFile("sudokulib_mapped_puzzles.txt", text);
+		{
+			const MappedPuzzleFile file(path.string().c_str());
+			ASSERT_TRUE(file.isOpen());
+			EXPECT_EQ(file.size(), text.size());
+			EXPECT_EQ(memcmp(file.data(), text.data(), text.size()), 0);
+
+			PuzzleTextReader reader = file.reader();
+			Board boards[4];
+			ASSERT_EQ(reader.read(boards), 3u);
+			for (uint i = 0; i < 3; ++i)
+				EXPECT_TRUE(boards[i] == Board::fromString(raw[i]));
+			EXPECT_TRUE(reader.isDone());
+		}
+		std::filesystem::remove(path);
+	}
+
+	TEST_F(SudokuLibFixture, validateMappedPuzzleFileEmpty)
+	{
+		// a zero byte file cannot be mapped, it still opens as a file without puzzles
+		const std::filesystem::path path = writeTempFile("sudokulib_mapped_empty.txt", std::string());
+		{
+			const MappedPuzzleFile file(path.string().c_str());
+			EXPECT_TRUE(file.isOpen());
+			EXPECT_EQ(file.size(), 0u);
+
+			PuzzleTextReader reader = file.reader();
+			Board board;
+			EXPECT_FALSE(reader.next(board));
+			EXPECT_TRUE(reader.isDone());
+		}
+		std::filesystem::remove(path);
+	}
+
 }
@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <bitset>
-#include <intrin.h>
 #include <map>
 #include <vector>
 
@@ -18,19 +17,8 @@ namespace ddahlkvist::techniques
 {
 	// each of the different techniques are residing within their own file that is forwarded from this point
 
-	std::vector<TechniqueFunction> allTechniques() {
-		static std::vector<TechniqueFunction> out = {
-			removeNaiveCandidates,
-			removeNakedSingle, removeHiddenSingle,
-			removeNakedPair, removeNakedTriplet,
-			removeHiddenPair, removeHiddenTriplet,
-			removeNakedQuad, removeHiddenQuad,
-			removePointingPair,
-			removeBoxLineReduction,
-			removeXWing, removeYWing,
-			removeSingleChain,
-			removeUniqueRectangle,
-		};
+	const std::vector<TechniqueFunction>& allTechniques() {
+		static const std::vector<TechniqueFunction> out = DefaultPipeline::asFunctions();
 		return out;
 	}
 }
\ No newline at end of file
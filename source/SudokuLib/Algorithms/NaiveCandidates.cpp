@@ -6,69 +6,63 @@
 
 namespace ddahlkvist::techniques
 {
-	void fillUnsolvedWithNonNaiveCandidates(SudokuContext& p)
+	namespace
 	{
-		p.result.Technique = Techniques::None;
-		BitBoard touchedNodes;
+		// removes the value of every pending solved node from its 20 peers, one and-not per value instead of walking all dimensions
+		void removePendingFromPeers(SudokuContext& p)
+		{
+			const BitBoard pending = p.PendingSolved;
+			p.PendingSolved = {};
+			if (!pending.notEmpty())
+				return;
 
-		for (auto&& dimension : p.AllDimensions) {
-			u8 nodeIds[9];
-			const u8 numSolved = (p.Solved & dimension).fillSetBits(nodeIds);
+			BoardBits::BitBoards9 peers{};
+			for (u16 value = 0; value < 9; ++value) {
+				const BitBoard newlySolved = pending & p.SolvedValues[value];
+				newlySolved.foreachSetBit([&peers, value](u32 nodeId) {
+					peers[value] |= BoardBits::Peers[nodeId];
+				});
+			}
 
-			if (numSolved < 9) {
-				const u16 solvedValues = buildSolvedMask(p, nodeIds, numSolved);
-				const u16 candidateMask = toCandidateMask(solvedValues);
+			// all nine candidate boards at once [BitKernels.h]
+			BoardBits::BitBoards9 badCandidates;
+			const BitBoard affectedNodes = bitKernels().removeFromCandidates(p.AllCandidates, badCandidates, peers);
+			if (!affectedNodes.notEmpty())
+				return;
 
-				(dimension & p.Unsolved).foreachSetBit([&p, &touchedNodes, solvedValues, candidateMask](u32 nodeId) {
-					Node& node = p.b.Nodes[nodeId];
-					if (touchedNodes.test(nodeId) == false) {
-						touchedNodes.setBit(nodeId);
-						node.candidatesSet(candidateMask);
-					}
-					else {
-						node.candidatesRemoveBySolvedMask(solvedValues);
-					}
-					});
+			p.result.storePreModification(p.b.Nodes, affectedNodes);
+			for (u16 value = 0; value < 9; ++value) {
+				const u16 candidateId = value + 1;
+				badCandidates[value].foreachSetBit([&p, candidateId](u32 nodeId) {
+					p.b.Nodes[nodeId].candidatesRemoveSingle(candidateId);
+				});
 			}
 		}
-		p.result.storePreModification(p.b.Nodes, touchedNodes);
 	}
 
-	bool removeNaiveCandidates(SudokuContext& p)
+	void fillUnsolvedWithNonNaiveCandidates(SudokuContext& p)
 	{
-		p.result.Technique = Techniques::NaiveCandidates;
+		p.result.Technique = Techniques::None;
 
-		// This algorithm will remove candidates from nodes because the value has been solved inside row/col/block [dimension]
-		// Meaning: if we have solved the value 4 inside block, then we remove 4 as a candidate from all other nodes inside that block
+		// every unsolved node starts with all candidates, then every solved node counts as newly solved
+		p.result.storePreModification(p.b.Nodes, p.Unsolved);
+		p.Unsolved.foreachSetBit([&p](u32 nodeId) {
+			p.b.Nodes[nodeId].candidatesSet(Candidates::All);
+		});
+		for (BitBoard& nodesWithCandidateX : p.AllCandidates)
+			nodesWithCandidateX = p.Unsolved;
 
-		// other attempt
-		// it feels like the current solution is doing a lot of if/else and taking small scale decisions by building and populating arrays, feels like it SHOULD be possible to solve the problem taking wider sweeps...
-		// it feels like we could utilize BitBoard for "solved" nodes and then compare that to "dimension + candidates"
-		// baseline for performance: 5ms, 3ms spent inside removeNaiveCandidates
+		p.PendingSolved = p.Solved;
+		removePendingFromPeers(p);
+	}
 
-		// ~[32-40]ms usually ~35ms
-		for (u16 value = 0; value < 9; ++value)
-		{
-			const BitBoard& nodesWhereValueIsKnown = p.SolvedValues[value];
-			if (!nodesWhereValueIsKnown.notEmpty())
-				continue;
+	bool removeNaiveCandidates(SudokuContext& p)
+	{
+		p.result.Technique = Techniques::NaiveCandidates;
 
-			for (auto&& dimension : p.AllDimensions)
-			{
-				const BitBoard solvedInDimension = nodesWhereValueIsKnown & dimension;
-				if (solvedInDimension.notEmpty())
-				{
-					const BitBoard badCandidates = p.AllCandidates[value] & dimension;
-					badCandidates.foreachSetBit([&](auto idx) {
-						Node& node = p.b.Nodes[idx];
-						p.result.append(node, idx);
-						const u16 candidateId = value + 1;
-						node.candidatesRemoveSingle(candidateId);
-					});
-				}
-			}
-		}
+		// only nodes solved since the last call [SudokuContext::PendingSolved] can remove anything, older ones already cleared their peers
+		removePendingFromPeers(p);
 
 		return p.result.size() > 0;
 	}
-}
\ No newline at end of file
+}
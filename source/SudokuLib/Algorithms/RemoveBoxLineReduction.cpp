@@ -13,33 +13,17 @@ namespace ddahlkvist::techniques
 			// if we know that the value must reside in ONE ROW and it is in the same block, all other nodes within that block can remove candidate since it must appear on that row/col 
 
 			// search for candidates contained in a row or column where they within that row/column are all in the same block (2-3)
-			// (candidates & row) -> "have same block" || (candidates & col) -> "have same block"
-			//		IF -> (candidates & blockId_from_previous) != (candidates & row) | (candidates & col)
-			//			(candidates & blockId_from_previous) ^ (candidates & row) | (candidates & col)
+			// that is a box/line segment holding every candidate of its line, the rest of the block is cleared [BoardBits::lockedCandidates]
 
 			for (uint c = 0; c < 9; ++c) {
-				const BitBoard& candidates = p.AllCandidates[c];
-				for (uint i = 0; i < 9; ++i) {
-					const BitBoard boards[2] = { candidates & BoardBits::BitRow(i), candidates & BoardBits::BitColumn(i) };
-
-					for (auto&& dimension : boards) {
-						if (dimension.countSetBits() >= 2) {
-							u8 blockId;
-							if (BoardBits::sharesBlock(blockId, dimension)) {
-								const BitBoard inBlock = candidates & BoardBits::BitBlock(blockId);
-								const BitBoard Diff = dimension ^ inBlock;
-								if (Diff.notEmpty()) {
-									p.result.storePreModification(p.b.Nodes, Diff);
-
-									const u16 candidate = static_cast<u16>(c + 1);
-									Diff.foreachSetBit([&p, candidate](u32 bit) {
-
-										p.b.Nodes[bit].candidatesRemoveSingle(candidate);
-									});
-								}
-							}
-						}
-					}
+				const BitBoard affectedNodes = BoardBits::lockedCandidates(p.AllCandidates[c]).claiming;
+				if (affectedNodes.notEmpty()) {
+					p.result.storePreModification(p.b.Nodes, affectedNodes);
+
+					const u16 candidate = static_cast<u16>(c + 1);
+					affectedNodes.foreachSetBit([&p, candidate](u32 bit) {
+						p.b.Nodes[bit].candidatesRemoveSingle(candidate);
+					});
 				}
 			}
 
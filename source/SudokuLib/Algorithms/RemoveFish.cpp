@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SudokuLib/SudokuAlgorithm.h>
+#include <SudokuLib/TechniqueMeta.h>
+#include <BoardUtils.h>
+#include <FishEngine.h>
+
+namespace ddahlkvist::techniques
+{
+		// fish are found on the context candidate boards [as they were when the technique started], the eliminations of one candidate never change the lines of another
+		bool removeFishInternal(SudokuContext& p, uint minSize, uint maxSize, bool finned) {
+			for (uint c = 0; c < 9; ++c) {
+				const fish::LineMasks lines = fish::lineMasksOf(p.AllCandidates[c]);
+
+				BitBoard affectedNodes;
+				for (uint size = minSize; size <= maxSize; ++size)
+					affectedNodes |= fish::fishEliminations(lines, size, finned);
+
+				if (affectedNodes.notEmpty()) {
+					p.result.storePreModification(p.b.Nodes, affectedNodes);
+
+					const u16 candidate = static_cast<u16>(c + 1);
+					affectedNodes.foreachSetBit([&p, candidate](u32 bit) {
+						p.b.Nodes[bit].candidatesRemoveSingle(candidate);
+					});
+				}
+			}
+
+			return p.result.size() > 0;
+		}
+
+		bool removeXWing(SudokuContext& p) {
+			p.result.Technique = Techniques::X_Wing;
+
+			//When there are only two possible cells for a value in each of two different rows,
+			//	and these candidates lie also in the same columns, (forms rectangle)
+			//	then all other candidates for this value in the columns can be eliminated.
+			//		or cells -> rows
+			return removeFishInternal(p, 2, 2, false);
+		}
+
+		bool removeSwordfish(SudokuContext& p) {
+			p.result.Technique = Techniques::Swordfish;
+
+			// three rows with the candidate in only three columns [not every row needs all three] --> the rest of those columns can drop it, or cells -> rows
+			return removeFishInternal(p, 3, 3, false);
+		}
+
+		bool removeJellyfish(SudokuContext& p) {
+			p.result.Technique = Techniques::Jellyfish;
+			return removeFishInternal(p, 4, 4, false);
+		}
+
+		bool removeFinnedFish(SudokuContext& p) {
+			p.result.Technique = Techniques::FinnedFish;
+
+			// a fish that would be complete if not for a few extra candidates [fins] within one block of its base lines
+			// either a fin holds the value or the fish does, the cover nodes in the fin block see both cases
+			return removeFishInternal(p, fish::MinSize, fish::MaxSize, true);
+		}
+}
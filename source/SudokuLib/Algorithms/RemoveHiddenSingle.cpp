@@ -10,46 +10,51 @@ namespace ddahlkvist::techniques
 	bool removeHiddenSingle(SudokuContext& p) {
 		p.result.Technique = Techniques::HiddenSingle;
 
-		BitBoard unhandledNodes(BitBoard::All{});
+		// every candidate that only one node in a unit can hold, for all units at once
+		const std::array<u16, 27> onlyOnceInUnit = BoardBits::candidatesSeenOncePerUnit(p.b.Nodes);
+
+		BitBoard affectedNodes;
 		u8 targetValue[BoardSize];
-		u8 affectedNodes[BoardSize];
-		u8 numAffectedNodes = 0;
-
-		{
-			for (uint c = 0; c < 9; ++c) {
-				for (uint i = 0; i < 27; ++i) {
-					// for all candidates , all possible directions, find unsolved with that candidate that we have not already fixed
-					const BitBoard maskedNodesWithCandidate = p.AllDimensions[i] & p.AllCandidates[c];
-					if (maskedNodesWithCandidate.countSetBits() == 1) {
-						const u32 bitPos = maskedNodesWithCandidate.firstOne();
-
-						if (unhandledNodes.test(bitPos))
-						{
-							unhandledNodes.clearBit(bitPos);
-
-							affectedNodes[numAffectedNodes] = static_cast<u8>(bitPos);
-							targetValue[numAffectedNodes] = static_cast<u8>(c + 1);
-
-							numAffectedNodes++;
-						}
-					}
-				}
+
+		const auto addHidden = [&affectedNodes, &targetValue](u32 nodeId, u16 hidden) {
+			// lowest value wins if a node is the only place for several [the board is broken and a later pass will notice]
+			affectedNodes.setBit(nodeId);
+			targetValue[nodeId] = static_cast<u8>(trailingZeros64(hidden));
+		};
+
+		const auto addHiddenLanes = [&p, &addHidden](u32 firstNodeId, u64 uniqueLanes) {
+			u64 hidden = BoardBits::candidateLanes(p.b.Nodes, firstNodeId) & uniqueLanes;
+			while (hidden != 0) {
+				const u32 lane = trailingZeros64(hidden) / 16;
+				addHidden(firstNodeId + lane, static_cast<u16>(hidden >> (16 * lane)));
+				hidden &= ~(0xFFFFull << (16 * lane));
 			}
+		};
+
+		// a row at a time as 4+4+1 nodes, each lane masked with what is unique in its row, column and block
+		const u64 columns0to3 = BoardBits::packLanes(onlyOnceInUnit[9], onlyOnceInUnit[10], onlyOnceInUnit[11], onlyOnceInUnit[12]);
+		const u64 columns4to7 = BoardBits::packLanes(onlyOnceInUnit[13], onlyOnceInUnit[14], onlyOnceInUnit[15], onlyOnceInUnit[16]);
+		for (u32 row = 0; row < 9; ++row) {
+			const u16* blocks = &onlyOnceInUnit[18 + (row / 3) * 3];
+			const u64 inRow = BoardBits::broadcastLanes(onlyOnceInUnit[row]);
+			const u32 firstNodeId = row * 9;
+
+			addHiddenLanes(firstNodeId, inRow | columns0to3 | BoardBits::packLanes(blocks[0], blocks[0], blocks[0], blocks[1]));
+			addHiddenLanes(firstNodeId + 4, inRow | columns4to7 | BoardBits::packLanes(blocks[1], blocks[1], blocks[2], blocks[2]));
+
+			const u16 hidden = p.b.Nodes[firstNodeId + 8].getCandidates() & (onlyOnceInUnit[row] | onlyOnceInUnit[17] | blocks[2]);
+			if (hidden != 0)
+				addHidden(firstNodeId + 8, hidden);
 		}
 
-		if (numAffectedNodes > 0) {
-			for (uint i = 0; i < numAffectedNodes; ++i) {
-				const u8 nodeId = affectedNodes[i];
-				p.result.append(p.b.Nodes[nodeId], nodeId);
-			}
-			for (uint i = 0; i < numAffectedNodes; ++i) {
-				const u8 nodeId = affectedNodes[i];
-				const u8 value = targetValue[i];
-				p.b.Nodes[nodeId].solve(value);
-			}
+		if (affectedNodes.notEmpty()) {
+			p.result.storePreModification(p.b.Nodes, affectedNodes);
+			affectedNodes.foreachSetBit([&p, &targetValue](u32 nodeId) {
+				p.b.Nodes[nodeId].solve(targetValue[nodeId]);
+			});
 		}
 
-		return numAffectedNodes > 0;
+		return affectedNodes.notEmpty();
 	}
 
 }
\ No newline at end of file
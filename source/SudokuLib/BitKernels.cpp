@@ -0,0 +1,317 @@
+#include <cstring>
+#include <immintrin.h>
+
+#include <Core/BitOps.h>
+#include <Core/CpuFeatures.h>
+#include <SudokuLib/sudokulib_module.h>
+#include <BitKernels.h>
+
+namespace ddahlkvist
+{
+	namespace
+	{
+		// result = nodes hit at least min times and at most max times, levels[i] --> nodes hit at least i+1 times
+		BitBoard candidateCountFromLevels(const BitBoard* levels, int min, int max) {
+			return levels[min - 1] & levels[max].invert();
+		}
+	}
+
+	// <Baseline>
+	namespace baseline
+	{
+		u8 fillSetBits(const BitBoard& board, u8* __restrict outNodeIds) {
+			return board.fillSetBitsPortable(outNodeIds);
+		}
+
+		u8 countSetBits(const BitBoard& board) {
+			return board.countSetBitsPortable();
+		}
+
+		BitBoard removeFromCandidates(BoardBits::BitBoards9& candidates, BoardBits::BitBoards9& outRemoved, const BoardBits::BitBoards9& peers) {
+			BitBoard removedAny;
+			for (uint i = 0; i < 9; ++i) {
+				outRemoved[i] = candidates[i] & peers[i];
+				candidates[i] ^= outRemoved[i];
+				removedAny |= outRemoved[i];
+			}
+			return removedAny;
+		}
+
+		BitBoard nodesWithCandidateCountBetweenXY(const BoardBits::BitBoards9& candidateBoards, int min, int max) {
+			// We track all nodes being hit at least once, at least twice etc... iterating "top to bottom" so each level is updated from the previous value of the level below.
+			// Levels above max are never needed, so they are not tracked.
+			BitBoard nodesBeingHitAtLeastXTimes[9];
+
+			for (const BitBoard& nodesWithCandidateX : candidateBoards) {
+				for (int i = max; i > 0; --i)
+					nodesBeingHitAtLeastXTimes[i] |= nodesBeingHitAtLeastXTimes[i - 1] & nodesWithCandidateX;
+
+				nodesBeingHitAtLeastXTimes[0] |= nodesWithCandidateX;
+			}
+
+			return candidateCountFromLevels(nodesBeingHitAtLeastXTimes, min, max);
+		}
+	}
+	// </Baseline>
+
+	// <Popcnt>
+	namespace popcnt
+	{
+		DD_TARGET_POPCNT u8 countSetBits(const BitBoard& board) {
+			return static_cast<u8>(_mm_popcnt_u64(board.word(0)) + _mm_popcnt_u64(board.word(1)));
+		}
+	}
+	// </Popcnt>
+
+	// <Avx2>
+	namespace avx2
+	{
+		// one iteration per set bit, the cheapest for sparse boards
+		DD_TARGET_AVX2 u8 fillSetBitsTzcnt(const BitBoard& board, u8* __restrict outNodeIds) {
+			u8* dest = outNodeIds;
+			for (u32 w = 0; w < 2; ++w) {
+				u64 word = board.word(w);
+				while (word != 0) {
+					*dest++ = static_cast<u8>(w * 64 + _tzcnt_u64(word));
+					word = _blsr_u64(word);
+				}
+			}
+			return static_cast<u8>(dest - outNodeIds);
+		}
+
+		// 8 bits at a time without a loop per set bit: pdep widens every bit of the byte to a whole byte, pext then packs the ids of the set bits to the front
+		// [pdep/pext are microcoded on amd before zen3, see CpuFeatures::fastPdep]
+		DD_TARGET_AVX2 u8 fillSetBitsPdep(const BitBoard& board, u8* __restrict outNodeIds, u32 total) {
+			constexpr u64 LowBitOfEachByte = 0x0101010101010101ULL;
+			constexpr u64 ByteIds = 0x0706050403020100ULL;
+
+			u32 numWritten = 0;
+			for (u32 w = 0; w < 2; ++w) {
+				u64 word = board.word(w);
+				for (u32 first = w * 64; word != 0; first += 8, word >>= 8) {
+					const u64 byteMask = _pdep_u64(word & 0xFF, LowBitOfEachByte) * 0xFF;
+					const u64 ids = _pext_u64(ByteIds + first * LowBitOfEachByte, byteMask);
+					const u32 numSet = static_cast<u32>(_mm_popcnt_u64(word & 0xFF));
+					// a full 8 byte store when it stays within the output, the caller only has room for the set bits
+					if (numWritten + 8 <= total) {
+						memcpy(outNodeIds + numWritten, &ids, 8);
+					}
+					else {
+						for (u32 i = 0; i < numSet; ++i)
+							outNodeIds[numWritten + i] = static_cast<u8>(ids >> (i * 8));
+					}
+					numWritten += numSet;
+				}
+			}
+			return static_cast<u8>(numWritten);
+		}
+
+		// boards with up to this many nodes are faster one bit at a time
+		constexpr u32 SparseBoardLimit = 8;
+
+		DD_TARGET_AVX2 u8 fillSetBits(const BitBoard& board, u8* __restrict outNodeIds) {
+			const u32 total = popcnt::countSetBits(board);
+			if (total <= SparseBoardLimit)
+				return fillSetBitsTzcnt(board, outNodeIds);
+			return fillSetBitsPdep(board, outNodeIds, total);
+		}
+
+		// candidates and peers of two values per register, the ninth value on its own
+		DD_TARGET_AVX2 BitBoard removeFromCandidates(BoardBits::BitBoards9& candidates, BoardBits::BitBoards9& outRemoved, const BoardBits::BitBoards9& peers) {
+			__m256i removedAny = _mm256_setzero_si256();
+			for (uint i = 0; i < 8; i += 2) {
+				const __m256i pairCandidates = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&candidates[i]));
+				const __m256i pairPeers = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&peers[i]));
+				const __m256i removed = _mm256_and_si256(pairCandidates, pairPeers);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&outRemoved[i]), removed);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&candidates[i]), _mm256_andnot_si256(pairPeers, pairCandidates));
+				removedAny = _mm256_or_si256(removedAny, removed);
+			}
+
+			const __m128i lastCandidates = candidates[8].asVector();
+			const __m128i lastPeers = peers[8].asVector();
+			const __m128i lastRemoved = _mm_and_si128(lastCandidates, lastPeers);
+			outRemoved[8] = BitBoard(lastRemoved);
+			candidates[8] = BitBoard(_mm_andnot_si128(lastPeers, lastCandidates));
+
+			const __m128i removedPairs = _mm_or_si128(_mm256_castsi256_si128(removedAny), _mm256_extracti128_si256(removedAny, 1));
+			return BitBoard(_mm_or_si128(removedPairs, lastRemoved));
+		}
+
+		// two levels per register, levels[k] holds "hit at least 2k+1 times" in the low lane and "at least 2k+2 times" in the high lane
+		template <int NumRegisters>
+		DD_TARGET_AVX2 BitBoard nodesWithCandidateCount(const BoardBits::BitBoards9& candidateBoards, int min, int max) {
+			const __m256i all = _mm256_broadcastsi128_si256(BitBoard(BitBoard::All{}).asVector());
+			__m256i levels[NumRegisters];
+			for (int k = 0; k < NumRegisters; ++k)
+				levels[k] = _mm256_setzero_si256();
+
+			for (const BitBoard& nodesWithCandidateX : candidateBoards) {
+				const __m256i hit = _mm256_broadcastsi128_si256(nodesWithCandidateX.asVector());
+				// every level moves up from the previous value of the level below, so walk top to bottom
+				for (int k = NumRegisters - 1; k >= 0; --k) {
+					const __m256i below = _mm256_permute2x128_si256(k == 0 ? all : levels[k - 1], levels[k], 0x21);
+					levels[k] = _mm256_or_si256(levels[k], _mm256_and_si256(below, hit));
+				}
+			}
+
+			alignas(32) BitBoard stored[NumRegisters * 2];
+			for (int k = 0; k < NumRegisters; ++k)
+				_mm256_store_si256(reinterpret_cast<__m256i*>(&stored[k * 2]), levels[k]);
+			return candidateCountFromLevels(stored, min, max);
+		}
+
+		DD_TARGET_AVX2 BitBoard nodesWithCandidateCountBetweenXY(const BoardBits::BitBoards9& candidateBoards, int min, int max) {
+			// levels 0..max are needed
+			switch ((max + 2) / 2) {
+			case 1: return nodesWithCandidateCount<1>(candidateBoards, min, max);
+			case 2: return nodesWithCandidateCount<2>(candidateBoards, min, max);
+			case 3: return nodesWithCandidateCount<3>(candidateBoards, min, max);
+			case 4: return nodesWithCandidateCount<4>(candidateBoards, min, max);
+			default: return nodesWithCandidateCount<5>(candidateBoards, min, max);
+			}
+		}
+	}
+	// </Avx2>
+
+	// <Avx512>
+	namespace avx512
+	{
+		// 16 bits at a time, the node ids of the set bits are compressed to the front and stored without touching memory past the last one
+		DD_TARGET_AVX512 u8 fillSetBits(const BitBoard& board, u8* __restrict outNodeIds) {
+			if (popcnt::countSetBits(board) <= avx2::SparseBoardLimit)
+				return avx2::fillSetBitsTzcnt(board, outNodeIds);
+
+			const __m512i offsets = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			u8* dest = outNodeIds;
+			for (u32 w = 0; w < 2; ++w) {
+				u64 word = board.word(w);
+				for (u32 first = w * 64; word != 0; first += 16, word >>= 16) {
+					const __mmask16 chunk = static_cast<__mmask16>(word);
+					const __m512i nodeIds = _mm512_add_epi32(offsets, _mm512_set1_epi32(static_cast<int>(first)));
+					const u32 numSet = static_cast<u32>(_mm_popcnt_u32(chunk));
+					const __mmask16 written = static_cast<__mmask16>((1u << numSet) - 1);
+					// maskz forms only, the unmasked ones start from an undefined register [gcc 12 -Wuninitialized]
+					const __m128i packed = _mm512_maskz_cvtepi32_epi8(written, _mm512_maskz_compress_epi32(chunk, nodeIds));
+					_mm_mask_storeu_epi8(dest, written, packed);
+					dest += numSet;
+				}
+			}
+			return static_cast<u8>(dest - outNodeIds);
+		}
+
+		// the board in all four 128-bit lanes
+		// [built with set4 instead of _mm512_broadcast_i32x4, gcc 12 starts the broadcast from an undefined register and warns about it]
+		DD_TARGET_AVX512 __m512i broadcastBoard(const BitBoard& board) {
+			const long long lower = static_cast<long long>(board.word(0));
+			const long long upper = static_cast<long long>(board.word(1));
+			return _mm512_set4_epi64(upper, lower, upper, lower);
+		}
+
+		// four values per register, 9 boards --> two full registers and one with a single board
+		DD_TARGET_AVX512 BitBoard removeFromCandidates(BoardBits::BitBoards9& candidates, BoardBits::BitBoards9& outRemoved, const BoardBits::BitBoards9& peers) {
+			__m512i removedAny = _mm512_setzero_si512();
+			for (uint i = 0; i < 9; i += 4) {
+				const __mmask8 lanes = i + 4 <= 9 ? __mmask8(0xFF) : __mmask8(0x03);
+				const __m512i quadCandidates = _mm512_maskz_loadu_epi64(lanes, &candidates[i]);
+				const __m512i quadPeers = _mm512_maskz_loadu_epi64(lanes, &peers[i]);
+				const __m512i removed = _mm512_and_si512(quadCandidates, quadPeers);
+				_mm512_mask_storeu_epi64(&outRemoved[i], lanes, removed);
+				_mm512_mask_storeu_epi64(&candidates[i], lanes, _mm512_andnot_si512(quadPeers, quadCandidates));
+				removedAny = _mm512_or_si512(removedAny, removed);
+			}
+
+			// fold the four lanes [maskz extract, the unmasked one starts from an undefined register]
+			const __m256i halves = _mm256_or_si256(_mm512_castsi512_si256(removedAny), _mm512_maskz_extracti64x4_epi64(0xF, removedAny, 1));
+			return BitBoard(_mm_or_si128(_mm256_castsi256_si128(halves), _mm256_extracti128_si256(halves, 1)));
+		}
+
+		// four levels per register, level k*4 + j in lane j of levels[k]
+		template <int NumRegisters>
+		DD_TARGET_AVX512 BitBoard nodesWithCandidateCount(const BoardBits::BitBoards9& candidateBoards, int min, int max) {
+			const __m512i all = broadcastBoard(BitBoard(BitBoard::All{}));
+			__m512i levels[NumRegisters];
+			for (int k = 0; k < NumRegisters; ++k)
+				levels[k] = _mm512_setzero_si512();
+
+			for (const BitBoard& nodesWithCandidateX : candidateBoards) {
+				const __m512i hit = broadcastBoard(nodesWithCandidateX);
+				for (int k = NumRegisters - 1; k >= 0; --k) {
+					// lanes [prev.3, cur.0, cur.1, cur.2]
+					const __m512i below = _mm512_maskz_alignr_epi64(0xFF, levels[k], k == 0 ? all : levels[k - 1], 6);
+					levels[k] = _mm512_ternarylogic_epi64(levels[k], below, hit, 0xF8); // levels | (below & hit)
+				}
+			}
+
+			alignas(64) BitBoard stored[NumRegisters * 4];
+			for (int k = 0; k < NumRegisters; ++k)
+				_mm512_store_si512(&stored[k * 4], levels[k]);
+			return candidateCountFromLevels(stored, min, max);
+		}
+
+		DD_TARGET_AVX512 BitBoard nodesWithCandidateCountBetweenXY(const BoardBits::BitBoards9& candidateBoards, int min, int max) {
+			switch ((max + 4) / 4) {
+			case 1: return nodesWithCandidateCount<1>(candidateBoards, min, max);
+			case 2: return nodesWithCandidateCount<2>(candidateBoards, min, max);
+			default: return nodesWithCandidateCount<3>(candidateBoards, min, max);
+			}
+		}
+	}
+	// </Avx512>
+
+	namespace
+	{
+		constexpr BitKernels AllBitKernels[] = {
+			{ BitKernelLevel::Baseline, "baseline", baseline::fillSetBits, baseline::countSetBits, baseline::removeFromCandidates, baseline::nodesWithCandidateCountBetweenXY },
+			{ BitKernelLevel::Popcnt, "popcnt", baseline::fillSetBits, popcnt::countSetBits, baseline::removeFromCandidates, baseline::nodesWithCandidateCountBetweenXY },
+			{ BitKernelLevel::Avx2, "avx2", avx2::fillSetBits, popcnt::countSetBits, avx2::removeFromCandidates, avx2::nodesWithCandidateCountBetweenXY },
+			{ BitKernelLevel::Avx512, "avx512", avx512::fillSetBits, popcnt::countSetBits, avx512::removeFromCandidates, avx512::nodesWithCandidateCountBetweenXY },
+		};
+		static_assert(std::size(AllBitKernels) == static_cast<size_t>(BitKernelLevel::Count));
+
+		const BitKernels* selectBestKernels() {
+			for (u32 i = static_cast<u32>(BitKernelLevel::Count); i > 0; --i) {
+				const BitKernelLevel level = static_cast<BitKernelLevel>(i - 1);
+				if (isSupported(level))
+					return &bitKernelsFor(level);
+			}
+			return &AllBitKernels[0];
+		}
+	}
+
+	bool isSupported(BitKernelLevel level) {
+		const CpuFeatures& f = cpuFeatures();
+		const bool avx2 = f.popcnt && f.avx2 && f.bmi1 && f.bmi2;
+		switch (level) {
+		case BitKernelLevel::Baseline: return true;
+		case BitKernelLevel::Popcnt: return f.popcnt;
+		case BitKernelLevel::Avx2: return avx2;
+		case BitKernelLevel::Avx512: return avx2 && f.avx512f && f.avx512bw && f.avx512vl;
+		default: return false;
+		}
+	}
+
+	const BitKernels& bitKernelsFor(BitKernelLevel level) {
+		assert(level < BitKernelLevel::Count);
+		return AllBitKernels[static_cast<u32>(level)];
+	}
+
+	// constant initialized, so they are valid during static initialization of other translation units
+	const BitKernels* ActiveBitKernels = &AllBitKernels[0];
+	FillSetBitsKernel ActiveFillSetBits = baseline::fillSetBits;
+	CountSetBitsKernel ActiveCountSetBits = baseline::countSetBits;
+
+	namespace
+	{
+		struct SelectBitKernelsAtStartup
+		{
+			SelectBitKernelsAtStartup() {
+				ActiveBitKernels = selectBestKernels();
+				const bool slowPdep = ActiveBitKernels->level == BitKernelLevel::Avx2 && !cpuFeatures().fastPdep;
+				ActiveFillSetBits = slowPdep ? avx2::fillSetBitsTzcnt : ActiveBitKernels->fillSetBits;
+				ActiveCountSetBits = ActiveBitKernels->countSetBits;
+			}
+		};
+		const SelectBitKernelsAtStartup selectBitKernelsAtStartup;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+
+// msvc accepts every intrinsic in every function, gcc/clang need the instruction set enabled per function
+#if defined(_MSC_VER)
+#define DD_TARGET(features)
+#else
+#define DD_TARGET(features) __attribute__((target(features)))
+#endif
+
+#define DD_TARGET_POPCNT DD_TARGET("popcnt")
+#define DD_TARGET_AVX2 DD_TARGET("avx2,bmi,bmi2,popcnt")
+#define DD_TARGET_AVX512 DD_TARGET("avx512f,avx512bw,avx512vl,avx2,bmi,bmi2,popcnt")
+
+namespace ddahlkvist
+{
+	// The hot bitboard routines are compiled once per instruction set level and the best level the cpu supports is picked at startup,
+	// a binary built for the baseline [plain x86-64] still runs the popcnt/avx2/avx-512 code on machines that have it.
+	enum class BitKernelLevel : u8
+	{
+		Baseline,	// sse2
+		Popcnt,		// sse2 + popcnt [nehalem and later]
+		Avx2,		// avx2 + bmi1 + bmi2 [haswell and later]
+		Avx512,		// avx512 f/bw/vl + Avx2 [skylake-sp and later]
+		Count
+	};
+
+	struct BitKernels
+	{
+		BitKernelLevel level;
+		const char* name;
+
+		// same contract as BitBoard::fillSetBits
+		u8 (*fillSetBits)(const BitBoard& board, u8* __restrict outNodeIds);
+
+		// same contract as BitBoard::countSetBits
+		u8 (*countSetBits)(const BitBoard& board);
+
+		// candidates[i] drops the nodes of peers[i], outRemoved[i] = the nodes that lost candidate i, returns the union of outRemoved
+		BitBoard (*removeFromCandidates)(BoardBits::BitBoards9& candidates, BoardBits::BitBoards9& outRemoved, const BoardBits::BitBoards9& peers);
+
+		// nodes with [min, max] candidates, 0 < min <= max < 9
+		BitBoard (*nodesWithCandidateCountBetweenXY)(const BoardBits::BitBoards9& candidateBoards, int min, int max);
+	};
+
+	bool isSupported(BitKernelLevel level);
+
+	// valid for every level, calling kernels of an unsupported level is undefined
+	const BitKernels& bitKernelsFor(BitKernelLevel level);
+
+	// best supported level, the baseline kernels until static initialization of SudokuLib has run
+	extern const BitKernels* ActiveBitKernels;
+
+	inline const BitKernels& bitKernels() {
+		return *ActiveBitKernels;
+	}
+}
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstring>
 #include <vector>
 
 #include <SudokuLib/sudokulib_module.h>
 #include <SudokuLib/SudokuTypes.h>
 #include <InternalSudokuTypes.h>
+#include <BitKernels.h>
 
 namespace ddahlkvist
 {
@@ -42,11 +44,11 @@ namespace ddahlkvist
 	}
 
 	inline u8 countBits(u32 data) {
-		return static_cast<u8>(__popcnt(data));
+		return static_cast<u8>(popCount32(static_cast<unsigned int>(data)));
 	}
 
 	inline u8 countCandidates(u16 with2nodes) {
-		return static_cast<u8>(__popcnt16(with2nodes));
+		return static_cast<u8>(popCount16(with2nodes));
 	}
 
 	inline u16 candidateIdToMask(u8 candidateId) {
@@ -65,80 +67,130 @@ namespace ddahlkvist
 
 	namespace BoardBits
 	{
-		constexpr SudokuBitBoard BitRow(uint rowId) {
-			SudokuBitBoard row{};
-			for (uint i = 0; i < 9; ++i)
-				row.setBit(i + rowId * 9);
-			return row;
-		}
+		// <Tables> built at compile time, techniques index into these instead of rebuilding row/column/block boards
 
-		constexpr SudokuBitBoard BitColumn(uint columnId) {
-			SudokuBitBoard col{};
-			for (uint i = 0; i < 9; ++i)
-				col.setBit(columnId + (i * 9));
-			return col;
-		}
+		// unit ids of a node, rows are units 0-8, columns 9-17 and blocks 18-26 [same order as SudokuContext::AllDimensions]
+		struct NodeUnits {
+			u8 row;
+			u8 column;
+			u8 block;
+		};
 
-		constexpr SudokuBitBoard BitBlock(uint blockId) {
-			SudokuBitBoard block{};
-			u16 top_left = topLeftFromblockId(blockId);
-			for (uint i = 0; i < 3; ++i)
-			{
-				block.setBit(top_left + i * 9 + 0);
-				block.setBit(top_left + i * 9 + 1);
-				block.setBit(top_left + i * 9 + 2);
+		// the 3 nodes a block shares with one of the rows or columns crossing it
+		struct BoxLineIntersection {
+			BitBoard nodes;
+			BitBoard blockRest;	// nodes of the block outside the segment
+			BitBoard lineRest;	// nodes of the line outside the segment
+			u8 blockId;
+			u8 lineUnit;	// unit id of the row [0-8] or column [9-17]
+		};
+
+		constexpr uint NumBoxLineIntersections = 54; // 9 blocks * (3 rows + 3 columns)
+
+		namespace tables {
+			constexpr BitBoards27 buildUnits() {
+				BitBoards27 units{};
+				for (uint nodeId = 0; nodeId < BoardSize; ++nodeId) {
+					units[BoardUtils::RowForNodeId(nodeId)].setBit(nodeId);
+					units[9 + BoardUtils::ColumnForNodeId(nodeId)].setBit(nodeId);
+					units[18 + BoardUtils::BlockForNodeId(nodeId)].setBit(nodeId);
+				}
+				return units;
+			}
+
+			constexpr std::array<NodeUnits, BoardSize> buildNodeUnits() {
+				std::array<NodeUnits, BoardSize> out{};
+				for (uint nodeId = 0; nodeId < BoardSize; ++nodeId) {
+					out[nodeId].row = static_cast<u8>(BoardUtils::RowForNodeId(nodeId));
+					out[nodeId].column = static_cast<u8>(9 + BoardUtils::ColumnForNodeId(nodeId));
+					out[nodeId].block = static_cast<u8>(18 + BoardUtils::BlockForNodeId(nodeId));
+				}
+				return out;
+			}
+
+			constexpr std::array<std::array<u8, 9>, 27> buildNodesOfUnit(const BitBoards27& units) {
+				std::array<std::array<u8, 9>, 27> out{};
+				for (uint unitId = 0; unitId < 27; ++unitId) {
+					uint numNodes = 0;
+					for (uint nodeId = 0; nodeId < BoardSize; ++nodeId) {
+						if (units[unitId].test(nodeId))
+							out[unitId][numNodes++] = static_cast<u8>(nodeId);
+					}
+				}
+				return out;
+			}
+
+			constexpr std::array<BitBoard, BoardSize> buildPeers(const BitBoards27& units) {
+				std::array<BitBoard, BoardSize> peers{};
+				for (uint nodeId = 0; nodeId < BoardSize; ++nodeId) {
+					const NodeUnits ids = buildNodeUnits()[nodeId];
+					peers[nodeId] = units[ids.row] | units[ids.column] | units[ids.block];
+					peers[nodeId].clearBit(nodeId);
+				}
+				return peers;
+			}
+
+			// block by block, the 3 rows crossing it and then the 3 columns
+			constexpr std::array<BoxLineIntersection, NumBoxLineIntersections> buildBoxLineIntersections(const BitBoards27& units) {
+				std::array<BoxLineIntersection, NumBoxLineIntersections> out{};
+				const auto intersect = [&units](uint blockId, uint lineUnit) {
+					const BitBoard& block = units[18 + blockId];
+					const BitBoard& line = units[lineUnit];
+					const BitBoard nodes = block & line;
+					return BoxLineIntersection{ nodes, block ^ nodes, line ^ nodes, static_cast<u8>(blockId), static_cast<u8>(lineUnit) };
+				};
+
+				uint numIntersections = 0;
+				for (uint blockId = 0; blockId < 9; ++blockId) {
+					const uint firstRow = (blockId / 3) * 3;
+					const uint firstColumn = (blockId % 3) * 3;
+					for (uint i = 0; i < 3; ++i)
+						out[numIntersections++] = intersect(blockId, firstRow + i);
+					for (uint i = 0; i < 3; ++i)
+						out[numIntersections++] = intersect(blockId, 9 + firstColumn + i);
+				}
+				return out;
 			}
-			return block;
 		}
 
+		inline constexpr BitBoards27 Units = tables::buildUnits();
+		inline constexpr std::array<NodeUnits, BoardSize> UnitsOfNode = tables::buildNodeUnits();
+		inline constexpr std::array<BitBoard, BoardSize> Peers = tables::buildPeers(Units);
+		inline constexpr std::array<std::array<u8, 9>, 27> NodesOfUnit = tables::buildNodesOfUnit(Units); // ascending node ids, position i in a unit is NodesOfUnit[unitId][i]
+		inline constexpr std::array<BoxLineIntersection, NumBoxLineIntersections> BoxLineIntersections = tables::buildBoxLineIntersections(Units);
+
+		// </Tables>
+
+		constexpr const SudokuBitBoard& BitRow(uint rowId) { return Units[rowId]; }
+		constexpr const SudokuBitBoard& BitColumn(uint columnId) { return Units[9 + columnId]; }
+		constexpr const SudokuBitBoard& BitBlock(uint blockId) { return Units[18 + blockId]; }
+
 		//////////////////////////////////////////////////////
 
 		constexpr BitBoards9 AllRows() {
 			BitBoards9 rows;
-			for (uint i = 0; i < 9; ++i)
-				rows[i] = BitRow(i);
+			std::copy_n(Units.begin(), 9, rows.begin());
 			return rows;
 		}
 
 		constexpr BitBoards9 AllColumns() {
 			BitBoards9 columns;
-			for (uint i = 0; i < 9; ++i)
-				columns[i] = BitColumn(i);
+			std::copy_n(Units.begin() + 9, 9, columns.begin());
 			return columns;
 		}
 
 		constexpr BitBoards9 AllBlocks() {
 			BitBoards9 blocks;
-			for (uint i = 0; i < 9; ++i)
-				blocks[i] = BitBlock(i);
+			std::copy_n(Units.begin() + 18, 9, blocks.begin());
 			return blocks;
 		}
 
 		inline void AllDimensions(BitBoards27& dimensions) {
-			auto populate = []() {
-				BitBoards27 out;
-
-				for (uint i = 0; i < 9; ++i) {
-					out[i] = BitRow(i);
-					out[i + 9] = BitColumn(i);
-					out[i + 18] = BitBlock(i);
-				}
-
-				return out;
-			};
-
-			static BitBoards27 CalculatedDimensions = populate();
-			dimensions = CalculatedDimensions;
+			dimensions = Units;
 		}
 
-		constexpr BitBoard NeighboursForNode(uint nodeId) {
-			const uint rowId = BoardUtils::RowForNodeId(nodeId);
-			const uint columnId = BoardUtils::ColumnForNodeId(nodeId);
-			const uint blockId = BoardUtils::BlockForNodeId(nodeId);
-
-			BitBoard b = BitRow(rowId) | BitColumn(columnId) | BitBlock(blockId);
-			b.clearBit(nodeId);
-			return b;
+		constexpr const BitBoard& NeighboursForNode(uint nodeId) {
+			return Peers[nodeId];
 		}
 
 		inline SudokuBitBoard NeighboursIntersection(u8* nodes, u8 numNodes) {
@@ -234,6 +286,56 @@ namespace ddahlkvist
 			unsolved.foreachSetBit(func);
 		}
 
+		// rebuild solved/candidate boards for the given nodes only, leaving all other nodes untouched
+		inline void refreshBitsForNodes(BitBoards9& outSolved9, BitBoards9& outCandidates, BitBoard& outAllSolved, const BitBoard& changedNodes, const Board& b) {
+			const BitBoard untouched = changedNodes.invert();
+			for (uint c = 0; c < 9; ++c) {
+				outSolved9[c] &= untouched;
+				outCandidates[c] &= untouched;
+			}
+			outAllSolved &= untouched;
+
+			changedNodes.foreachSetBit([&](u32 idx) {
+				const Node& node = b.Nodes[idx];
+				if (node.isSolved()) {
+					outSolved9[node.getValue() - 1].setBit(idx);
+					outAllSolved.setBit(idx);
+					return;
+				}
+
+				const u16 candidate = node.getCandidates();
+				for (u16 c = 0; c < 9; ++c) {
+					if (candidate & AllCandidatesArray[c]) {
+						outCandidates[c].setBit(idx);
+					}
+				}
+			});
+		}
+
+		// true if the context can no longer lead to a valid solution
+		// [unsolved node without candidates, value solved twice in a dimension, value with nowhere left to go in a dimension]
+		inline bool hasContradiction(const SudokuContext& p) {
+			BitBoard nodesWithCandidates;
+			for (auto&& candidates : p.AllCandidates)
+				nodesWithCandidates |= candidates;
+
+			if ((p.Unsolved & nodesWithCandidates.invert()).notEmpty())
+				return true;
+
+			for (uint c = 0; c < 9; ++c) {
+				const BitBoard& solved = p.SolvedValues[c];
+				const BitBoard placeable = solved | p.AllCandidates[c];
+				for (auto&& dimension : p.AllDimensions) {
+					if (!(placeable & dimension).notEmpty())
+						return true;
+					if ((solved & dimension).countSetBits() > 1)
+						return true;
+				}
+			}
+
+			return false;
+		}
+
 		inline u8 rowToDimension(u32 i) { return static_cast<u8>(i); }
 		inline u8 colToDimension(u32 i) { return static_cast<u8>(i + 9u); }
 		inline u8 blockToDimension(u32 i) { return static_cast<u8>(i + 18u); }
@@ -274,37 +376,48 @@ namespace ddahlkvist
 			return out;
 		}
 
+		// only the unit of the first node can hold all of them [an empty board fits in unit 0]
+		inline bool sharesUnit(u8& outUnitId, const BitBoard& nodes, u8 NodeUnits::* unitOfNode, u8 firstUnit) {
+			const u8 unitId = nodes.notEmpty() ? UnitsOfNode[nodes.firstOne()].*unitOfNode : firstUnit;
+			if ((nodes & Units[unitId]) != nodes)
+				return false;
+			outUnitId = static_cast<u8>(unitId - firstUnit);
+			return true;
+		}
+
 		inline bool sharesBlock(u8& outBlockId, const BitBoard& nodes) {
-			for (uint i = 0; i < 9; ++i) {
-				const BitBoard inDimension = BitBlock(i) & nodes;
-				if (inDimension == nodes) {
-					outBlockId = static_cast<u8>(i);
-					return true;
-				}
-			}
-			return false;
+			return sharesUnit(outBlockId, nodes, &NodeUnits::block, 18);
 		}
 
 		inline bool sharesColumn(u8& outColumnId, const BitBoard& nodes) {
-			for (uint i = 0; i < 9; ++i) {
-				const BitBoard inDimension = BitColumn(i) & nodes;
-				if (inDimension == nodes) {
-					outColumnId = static_cast<u8>(i);
-					return true;
-				}
-			}
-			return false;
+			return sharesUnit(outColumnId, nodes, &NodeUnits::column, 9);
 		}
 
 		inline bool sharesRow(u8& outRowId, const BitBoard& nodes) {
-			for (uint i = 0; i < 9; ++i) {
-				const BitBoard inDimension = BitRow(i) & nodes;
-				if (inDimension == nodes) {
-					outRowId = static_cast<u8>(i);
-					return true;
-				}
+			return sharesUnit(outRowId, nodes, &NodeUnits::row, 0);
+		}
+
+		// locked candidates for one candidate board, pointing and claiming are both decided per box/line segment
+		struct LockedCandidates {
+			BitBoard pointing;	// the block only holds the candidate inside one segment --> the rest of that line can drop it
+			BitBoard claiming;	// the line only holds the candidate inside one segment [at least 2 nodes] --> the rest of that block can drop it
+		};
+
+		inline LockedCandidates lockedCandidates(const BitBoard& candidates) {
+			LockedCandidates out;
+			for (const BoxLineIntersection& segment : BoxLineIntersections) {
+				const BitBoard inSegment = candidates & segment.nodes;
+				if (!inSegment.notEmpty())
+					continue;
+
+				const BitBoard inBlockRest = candidates & segment.blockRest;
+				const BitBoard inLineRest = candidates & segment.lineRest;
+				if (!inBlockRest.notEmpty())
+					out.pointing |= inLineRest;
+				if (!inLineRest.notEmpty() && inSegment.countSetBits() >= 2)
+					out.claiming |= inBlockRest;
 			}
-			return false;
+			return out;
 		}
 
 		// If a candidate appears EXACTLY twice in a unit, then those two candidates are called a conjugate pair.
@@ -374,47 +487,104 @@ namespace ddahlkvist
 			return hitTwice & (invalidated.invert());
 		}
 		 
-		inline BitBoard nodesWithCandidateCountBetweenXY(const BoardBits::BitBoards9& candidateBoards, int min, int max) {
-			assert(min != 0);
-			assert(max < 9);
-			// Algorithm description: We iterate over each candidate board [each bit indicates THAT NODE consider candidateX a possibility]
-			// We track all nodes being hit at least once, at least twice, at least thrice etc...
-			// Then --> Each node previously hit 3 times + hit --> hit 4 times
-			// Then --> Each node previously hit 2 times + hit --> hit 3 times
-			// by appending to "hit_3_times_mask" we make sure that the aggregated result is correct
-			// iteration order of "top to bottom" solves the counting
-
-			BitBoard nodesBeingHitAtLeastXTimes[9];
-
-			for (auto& nodesWithCandidateX : candidateBoards) {
-				// update how many times each node has been populated with a candidate by iterating from "most" and comparing to "most-1"
-				// for correctness we should go from 9 --> 0, but since we know that we do not need to track orders above the treshold [max] we can just ignore any higher values
-				for (uint i = max; i > 0; --i)
-				{
-					BitBoard& nodesWithCandidateCount_i = nodesBeingHitAtLeastXTimes[i];
-					BitBoard& nodesWithPrevCandidateCount = nodesBeingHitAtLeastXTimes[i-1];
+		// candidate masks of 4 consecutive nodes, node firstNodeId in the lowest u16 lane
+		inline u64 candidateLanes(const Node* nodes, uint firstNodeId) {
+			static_assert(sizeof(Node) == sizeof(u16));
+			constexpr u64 CandidateBits = 0x03FF'03FF'03FF'03FFull; // drops the value and solved bits
+
+			u64 lanes;
+			std::memcpy(&lanes, &nodes[firstNodeId], sizeof(lanes));
+			return lanes & CandidateBits;
+		}
 
-					const BitBoard newNodesWithCount_i = nodesWithPrevCandidateCount & nodesWithCandidateX;
-					nodesWithCandidateCount_i |= newNodesWithCount_i;
-				}
+		constexpr u64 broadcastLanes(u16 mask) { return mask * 0x0001'0001'0001'0001ull; }
 
-				// make sure all nodes that have a candidate are marked as having at least one candidate
-				nodesBeingHitAtLeastXTimes[0] |= nodesWithCandidateX;
+		constexpr u64 packLanes(u16 lane0, u16 lane1, u16 lane2, u16 lane3) {
+			return u64(lane0) | (u64(lane1) << 16) | (u64(lane2) << 32) | (u64(lane3) << 48);
+		}
+
+		// once/twice accumulation on candidate masks, T is a single u16 mask or 4 u16 lanes packed in a u64
+		template<typename T>
+		struct SeenCount {
+			T once = 0;
+			T twice = 0;
+
+			void add(T candidates) {
+				twice |= once & candidates;
+				once |= candidates;
 			}
 
-			// at this point we know exactly how many times each node has been "hit"
-			// now we just need to find everyone that has been hit in the range min, max
-			// this is most easily done by aggregating results in range [min, max] and then remove the ones found in "max+1"
-			BitBoard potentials;
-			for (int i = min; i <= max; ++i)
-			{
-				potentials |= nodesBeingHitAtLeastXTimes[i-1];
+			void add(const SeenCount& other) {
+				twice |= other.twice | (once & other.once);
+				once |= other.once;
 			}
 
-			// clear out anyone being hit more than "max times" [the array is 0-based so idx=0 are the ones that have been hit 1 time]
-			potentials &= nodesBeingHitAtLeastXTimes[max].invert();
+			T exactlyOnce() const { return once & ~twice; }
+
+			SeenCount<u16> lane(uint i) const { return { static_cast<u16>(once >> (16 * i)), static_cast<u16>(twice >> (16 * i)) }; }
+		};
 
-			return potentials;
+		// candidates [Node::getCandidates layout] found in exactly one node of each unit, all 27 units and all 9 values at once
+		// same accumulation as nodesWithExactlyTwoCandidates but over the nodes of a unit, a row is read as 4+4+1 nodes [u16 lanes in a u64]
+		inline std::array<u16, 27> candidatesSeenOncePerUnit(const Node* nodes) {
+			std::array<u16, 27> seenOnce;
+			SeenCount<u64> columns0to3;
+			SeenCount<u64> columns4to7;
+			SeenCount<u16> column8;
+
+			for (uint band = 0; band < 3; ++band) {
+				SeenCount<u64> band0to3;
+				SeenCount<u64> band4to7;
+				SeenCount<u16> band8;
+
+				for (uint row = band * 3; row < band * 3 + 3; ++row) {
+					const u64 left = candidateLanes(nodes, row * 9);
+					const u64 right = candidateLanes(nodes, row * 9 + 4);
+					const u16 last = nodes[row * 9 + 8].getCandidates();
+					band0to3.add(left);
+					band4to7.add(right);
+					band8.add(last);
+
+					// fold the 8 lanes into lane 0
+					SeenCount<u64> inRow;
+					inRow.add(left);
+					inRow.add(right);
+					inRow.add(SeenCount<u64>{ inRow.once >> 32, inRow.twice >> 32 });
+					inRow.add(SeenCount<u64>{ inRow.once >> 16, inRow.twice >> 16 });
+					SeenCount<u16> rowCount = inRow.lane(0);
+					rowCount.add(last);
+					seenOnce[row] = rowCount.exactlyOnce();
+				}
+
+				SeenCount<u16> blocks[3] = { band0to3.lane(0), band0to3.lane(3), band4to7.lane(2) };
+				blocks[0].add(band0to3.lane(1));
+				blocks[0].add(band0to3.lane(2));
+				blocks[1].add(band4to7.lane(0));
+				blocks[1].add(band4to7.lane(1));
+				blocks[2].add(band4to7.lane(3));
+				blocks[2].add(band8);
+				for (uint i = 0; i < 3; ++i)
+					seenOnce[18 + band * 3 + i] = blocks[i].exactlyOnce();
+
+				columns0to3.add(band0to3);
+				columns4to7.add(band4to7);
+				column8.add(band8);
+			}
+
+			for (uint i = 0; i < 4; ++i) {
+				seenOnce[9 + i] = columns0to3.lane(i).exactlyOnce();
+				seenOnce[13 + i] = columns4to7.lane(i).exactlyOnce();
+			}
+			seenOnce[17] = column8.exactlyOnce();
+			return seenOnce;
+		}
+
+		inline BitBoard nodesWithCandidateCountBetweenXY(const BoardBits::BitBoards9& candidateBoards, int min, int max) {
+			assert(min != 0);
+			assert(max < 9);
+			// Algorithm description: We iterate over each candidate board [each bit indicates THAT NODE consider candidateX a possibility]
+			// We track all nodes being hit at least once, at least twice, at least thrice etc... [see BitKernels.cpp]
+			return bitKernels().nodesWithCandidateCountBetweenXY(candidateBoards, min, max);
 		}
 	}
 
@@ -0,0 +1,277 @@
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+#include <BoardUtils.h>
+#include <FishEngine.h>
+#include <SubsetEngine.h>
+#include <CandidateState.h>
+
+namespace ddahlkvist
+{
+	namespace
+	{
+		constexpr const BitBoard& neighboursOf(u32 nodeId) {
+			return BoardBits::Peers[nodeId];
+		}
+
+		// unsolved node with the fewest candidates [at least two, singles are already placed by propagateSingles]
+		u32 nodeWithFewestCandidates(const CandidateState& s) {
+			// nodesWithAtLeast[i] --> nodes with at least i+1 candidates
+			BitBoard nodesWithAtLeast[9];
+			for (const BitBoard& nodesWithCandidateX : s.candidates) {
+				for (uint i = 8; i > 0; --i)
+					nodesWithAtLeast[i] |= nodesWithAtLeast[i - 1] & nodesWithCandidateX;
+				nodesWithAtLeast[0] |= nodesWithCandidateX;
+			}
+
+			for (uint i = 1; i < 8; ++i) {
+				const BitBoard exactly = nodesWithAtLeast[i] & nodesWithAtLeast[i + 1].invert();
+				if (exactly.notEmpty())
+					return exactly.firstOne();
+			}
+			return nodesWithAtLeast[8].firstOne();
+		}
+
+		// pointing and claiming for every candidate [BoardBits::lockedCandidates]
+		bool removeLockedCandidates(CandidateState& s) {
+			bool removed = false;
+			for (BitBoard& nodesWithCandidateX : s.candidates) {
+				const BoardBits::LockedCandidates locked = BoardBits::lockedCandidates(nodesWithCandidateX);
+				const BitBoard affectedNodes = nodesWithCandidateX & (locked.pointing | locked.claiming);
+				if (affectedNodes.notEmpty()) {
+					nodesWithCandidateX ^= affectedNodes;
+					removed = true;
+				}
+			}
+			return removed;
+		}
+
+		// the subsets are found on per-node masks derived from the candidate boards as they were when the search started
+		bool removeNakedSubsets(CandidateState& s, uint size) {
+			bool removed = false;
+			subsets::foreachNakedSubset(subsets::BoardCandidates(s.candidates), size, [&s, &removed](const subsets::SubsetMatch& match) {
+				u8 nodeIds[subsets::MaxSize];
+				const u8 numNodes = subsets::nodeIdsOf(match, nodeIds);
+				const BitBoard sharedNeighbours = BoardBits::NeighboursUnion_ifAllNodesAreSameDimension(nodeIds, numNodes);
+
+				for (u32 c : SetBits<u16>(match.candidates)) {
+					const BitBoard affectedNodes = s.candidates[c] & sharedNeighbours;
+					if (affectedNodes.notEmpty()) {
+						s.candidates[c] ^= affectedNodes;
+						removed = true;
+					}
+				}
+			});
+			return removed;
+		}
+
+		bool removeHiddenSubsets(CandidateState& s, uint size) {
+			bool removed = false;
+			subsets::foreachHiddenSubset(subsets::BoardCandidates(s.candidates), size, [&s, &removed](const subsets::SubsetMatch& match) {
+				u8 nodeIds[subsets::MaxSize];
+				const u8 numNodes = subsets::nodeIdsOf(match, nodeIds);
+				BitBoard nodes;
+				for (uint i = 0; i < numNodes; ++i)
+					nodes.setBit(nodeIds[i]);
+
+				// the nodes of the subset drop every other candidate
+				const u16 otherCandidates = static_cast<u16>(~match.candidates & 0x1FF);
+				for (u32 c : SetBits<u16>(otherCandidates)) {
+					const BitBoard affectedNodes = s.candidates[c] & nodes;
+					if (affectedNodes.notEmpty()) {
+						s.candidates[c] ^= affectedNodes;
+						removed = true;
+					}
+				}
+			});
+			return removed;
+		}
+
+		// X-Wing, Swordfish and Jellyfish [no fins], each candidate board on its own
+		bool removeFish(CandidateState& s) {
+			bool removed = false;
+			for (BitBoard& nodesWithCandidateX : s.candidates) {
+				const fish::LineMasks lines = fish::lineMasksOf(nodesWithCandidateX);
+				BitBoard affectedNodes;
+				for (uint size = fish::MinSize; size <= fish::MaxSize; ++size)
+					affectedNodes |= fish::fishEliminations(lines, size, false);
+
+				affectedNodes &= nodesWithCandidateX;
+				if (affectedNodes.notEmpty()) {
+					nodesWithCandidateX ^= affectedNodes;
+					removed = true;
+				}
+			}
+			return removed;
+		}
+	}
+
+	bool CandidateState::fromBoard(const Board& b, CandidateState& outState) {
+		CandidateState s;
+		for (uint i = 0; i < BoardSize; ++i) {
+			const Node& node = b.Nodes[i];
+			if (!node.isSolved())
+				continue;
+
+			const u32 candidateId = node.getValue() - 1u;
+			if ((s.solved[candidateId] & neighboursOf(i)).notEmpty())
+				return false;
+			s.solved[candidateId].setBit(i);
+		}
+
+		const BitBoard unsolved = s.unsolved();
+		for (uint c = 0; c < 9; ++c) {
+			BitBoard seen;
+			s.solved[c].foreachSetBit([&seen](u32 nodeId) {
+				seen |= neighboursOf(nodeId);
+			});
+			s.candidates[c] = unsolved & seen.invert();
+		}
+
+		outState = s;
+		return true;
+	}
+
+	void CandidateState::writeToBoard(Board& b) const {
+		for (uint i = 0; i < BoardSize; ++i)
+			b.Nodes[i] = Node();
+
+		for (uint c = 0; c < 9; ++c) {
+			solved[c].foreachSetBit([&b, c](u32 nodeId) {
+				b.Nodes[nodeId].solve(c + 1);
+			});
+		}
+
+		unsolved().foreachSetBit([this, &b](u32 nodeId) {
+			b.Nodes[nodeId].candidatesSet(candidatesOf(nodeId));
+		});
+	}
+
+	u16 CandidateState::candidatesOf(u32 nodeId) const {
+		u16 mask = 0;
+		for (uint c = 0; c < 9; ++c) {
+			if (candidates[c].test(nodeId))
+				mask |= AllCandidatesArray[c];
+		}
+		return mask;
+	}
+
+	BitBoard CandidateState::allSolved() const {
+		BitBoard all;
+		for (const BitBoard& nodes : solved)
+			all |= nodes;
+		return all;
+	}
+
+	bool CandidateState::place(u32 nodeId, u32 candidateId) {
+		const BitBoard& neighbours = neighboursOf(nodeId);
+		if ((solved[candidateId] & neighbours).notEmpty())
+			return false;
+
+		BitBoard node;
+		node.setBit(nodeId);
+		const BitBoard otherNodes = node.invert();
+		for (BitBoard& nodesWithCandidateX : candidates)
+			nodesWithCandidateX &= otherNodes;
+
+		candidates[candidateId] &= neighbours.invert();
+		solved[candidateId] |= node;
+		return true;
+	}
+
+	bool propagateSingles(CandidateState& s) {
+		const BoardBits::BitBoards27& allDimensions = BoardBits::Units;
+
+		bool progressed = true;
+		while (progressed) {
+			progressed = false;
+
+			// count candidates for all nodes at once, only "at least one" and "at least two" are needed
+			BitBoard atLeastOne;
+			BitBoard atLeastTwo;
+			for (const BitBoard& nodesWithCandidateX : s.candidates) {
+				atLeastTwo |= atLeastOne & nodesWithCandidateX;
+				atLeastOne |= nodesWithCandidateX;
+			}
+
+			if ((s.unsolved() & atLeastOne.invert()).notEmpty())
+				return false;
+
+			const BitBoard nakedSingles = atLeastOne & atLeastTwo.invert();
+			if (nakedSingles.notEmpty()) {
+				for (uint c = 0; c < 9; ++c) {
+					bool valid = true;
+					(nakedSingles & s.candidates[c]).foreachSetBit([&s, &valid, c](u32 nodeId) {
+						valid = valid && s.place(nodeId, c);
+					});
+					if (!valid)
+						return false;
+				}
+				progressed = true;
+				continue;
+			}
+
+			for (uint c = 0; c < 9; ++c) {
+				for (const BitBoard& dimension : allDimensions) {
+					const BitBoard inDimension = s.candidates[c] & dimension;
+					const u8 numNodes = inDimension.countSetBits();
+					if (numNodes == 1) {
+						if (!s.place(inDimension.firstOne(), c))
+							return false;
+						progressed = true;
+					}
+					else if (numNodes == 0 && !(s.solved[c] & dimension).notEmpty()) {
+						return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool eliminateCandidates(CandidateState& s) {
+		if (removeLockedCandidates(s))
+			return true;
+
+		for (uint size = subsets::MinSize; size <= subsets::MaxSize; ++size) {
+			if (removeNakedSubsets(s, size) || removeHiddenSubsets(s, size))
+				return true;
+		}
+
+		return removeFish(s);
+	}
+
+	namespace
+	{
+		// the techniques only run before the first guess, below it they cost more per guess than the guesses they save [even locked candidates]
+		bool searchCandidateState(CandidateState& s, bool isRoot) {
+			do {
+				if (!propagateSingles(s))
+					return false;
+
+				if (!s.unsolved().notEmpty())
+					return true;
+			} while (isRoot && eliminateCandidates(s));
+
+			const u32 nodeId = nodeWithFewestCandidates(s);
+			const u16 candidates = s.candidatesOf(nodeId);
+			for (uint c = 0; c < 9; ++c) {
+				if ((candidates & AllCandidatesArray[c]) == 0)
+					continue;
+
+				// the whole state is 18 bitboards, a copy per guess is cheaper than undoing the propagation
+				CandidateState guess = s;
+				if (guess.place(nodeId, c) && searchCandidateState(guess, false)) {
+					s = guess;
+					return true;
+				}
+			}
+
+			return false;
+		}
+	}
+
+	bool solveCandidateState(CandidateState& s) {
+		return searchCandidateState(s, true);
+	}
+}
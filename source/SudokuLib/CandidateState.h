@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+
+namespace ddahlkvist
+{
+	// Candidate-major board state, the per-digit boards are the only state and per-node masks are derived on demand.
+	// candidates[c] holds the unsolved nodes where candidateId c is still possible, solved[c] the nodes solved with value c+1.
+	struct CandidateState
+	{
+		BoardBits::BitBoards9 candidates;
+		BoardBits::BitBoards9 solved;
+
+		// solved nodes are kept, every unsolved node gets all values not already solved by one of its neighbours
+		// returns false if two solved nodes with the same value see each other
+		static bool fromBoard(const Board& b, CandidateState& outState);
+
+		// solved nodes get their value, unsolved nodes their candidate mask
+		void writeToBoard(Board& b) const;
+
+		// same layout as Node::getCandidates [candidateId c --> bit c+1]
+		u16 candidatesOf(u32 nodeId) const;
+
+		BitBoard allSolved() const;
+		BitBoard unsolved() const { return allSolved().invert(); }
+
+		// solves the node and removes the candidate from all its neighbours, returns false if a neighbour is already solved with the same value
+		bool place(u32 nodeId, u32 candidateId);
+	};
+
+	// places naked and hidden singles until neither makes progress, returns false on a contradiction
+	bool propagateSingles(CandidateState& s);
+
+	// the bitboard techniques of the pipeline run directly on the candidate boards [locked candidates, naked/hidden subsets, fish]
+	// cheapest first, returns true as soon as one of them removed a candidate so the singles get another go
+	bool eliminateCandidates(CandidateState& s);
+
+	// propagateSingles and eliminateCandidates until both are stuck, then branches on the node with the fewest candidates [singles only below the first guess]
+	// returns true with the state solved
+	bool solveCandidateState(CandidateState& s);
+}
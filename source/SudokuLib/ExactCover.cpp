@@ -0,0 +1,192 @@
+#include <cstring>
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+#include <BoardUtils.h>
+#include <ExactCover.h>
+
+namespace ddahlkvist
+{
+	namespace
+	{
+		constexpr u16 RootNode = 0;
+		constexpr u16 headerNode(u32 column) { return static_cast<u16>(column + 1); }
+		constexpr u16 firstRowNode(u32 row) { return static_cast<u16>(1 + ExactCoverMatrix::NumColumns + row * 4); }
+
+		void fillColumnsForRow(u32 row, u32* outColumns) {
+			const u32 nodeId = row / 9;
+			const u32 valueId = row % 9;
+			outColumns[0] = nodeId;
+			outColumns[1] = BoardSize * 1 + BoardUtils::RowForNodeId(nodeId) * 9 + valueId;
+			outColumns[2] = BoardSize * 2 + BoardUtils::ColumnForNodeId(nodeId) * 9 + valueId;
+			outColumns[3] = BoardSize * 3 + BoardUtils::BlockForNodeId(nodeId) * 9 + valueId;
+		}
+
+		void buildPristine(ExactCoverMatrix& m) {
+			using Links = ExactCoverMatrix::Links;
+
+			// header list, circular through the root
+			for (u32 i = 0; i <= ExactCoverMatrix::NumColumns; ++i) {
+				const u16 node = static_cast<u16>(i);
+				Links& links = m.nodes[node];
+				links.left = static_cast<u16>(i == 0 ? ExactCoverMatrix::NumColumns : i - 1);
+				links.right = static_cast<u16>(i == ExactCoverMatrix::NumColumns ? 0 : i + 1);
+				links.up = node;
+				links.down = node;
+				links.column = node;
+				links.row = 0;
+				m.sizes[node] = 0;
+				m.covered[node] = false;
+			}
+
+			for (u32 row = 0; row < ExactCoverMatrix::NumRows; ++row) {
+				u32 columns[4];
+				fillColumnsForRow(row, columns);
+
+				const u16 first = firstRowNode(row);
+				for (u16 k = 0; k < 4; ++k) {
+					const u16 node = first + k;
+					const u16 header = headerNode(columns[k]);
+					Links& links = m.nodes[node];
+
+					links.left = first + ((k + 3) % 4);
+					links.right = first + ((k + 1) % 4);
+					links.column = header;
+					links.row = static_cast<u16>(row);
+
+					// append at the bottom of the column
+					links.down = header;
+					links.up = m.nodes[header].up;
+					m.nodes[links.up].down = node;
+					m.nodes[header].up = node;
+					m.sizes[header]++;
+					m.covered[node] = false;
+				}
+			}
+		}
+	}
+
+	const ExactCoverMatrix& ExactCoverMatrix::pristine() {
+		static const ExactCoverMatrix matrix = []() {
+			ExactCoverMatrix m;
+			buildPristine(m);
+			return m;
+		}();
+		return matrix;
+	}
+
+	ExactCoverSolver::ExactCoverSolver()
+		: _matrix(ExactCoverMatrix::pristine())
+	{
+	}
+
+	void ExactCoverSolver::cover(u16 column) {
+		auto& n = _matrix.nodes;
+		n[n[column].right].left = n[column].left;
+		n[n[column].left].right = n[column].right;
+		_matrix.covered[column] = true;
+
+		for (u16 i = n[column].down; i != column; i = n[i].down) {
+			for (u16 j = n[i].right; j != i; j = n[j].right) {
+				n[n[j].down].up = n[j].up;
+				n[n[j].up].down = n[j].down;
+				_matrix.sizes[n[j].column]--;
+			}
+		}
+	}
+
+	void ExactCoverSolver::uncover(u16 column) {
+		auto& n = _matrix.nodes;
+		for (u16 i = n[column].up; i != column; i = n[i].up) {
+			for (u16 j = n[i].left; j != i; j = n[j].left) {
+				_matrix.sizes[n[j].column]++;
+				n[n[j].down].up = j;
+				n[n[j].up].down = j;
+			}
+		}
+
+		_matrix.covered[column] = false;
+		n[n[column].right].left = column;
+		n[n[column].left].right = column;
+	}
+
+	bool ExactCoverSolver::loadGivens(const Board& b) {
+		for (u32 i = 0; i < BoardSize; ++i) {
+			const Node& node = b.Nodes[i];
+			if (!node.isSolved())
+				continue;
+
+			u32 columns[4];
+			fillColumnsForRow(i * 9 + node.getValue() - 1, columns);
+			for (u32 column : columns) {
+				const u16 header = headerNode(column);
+				if (_matrix.covered[header])
+					return false;
+				cover(header);
+				_givenColumns[_numGivenColumns++] = header;
+			}
+		}
+		return true;
+	}
+
+	void ExactCoverSolver::clearGivens() {
+		while (_numGivenColumns > 0)
+			uncover(_givenColumns[--_numGivenColumns]);
+		_solutionSize = 0;
+	}
+
+	u32 ExactCoverSolver::search(u32 limit) {
+		_solutionSize = 0;
+		if (limit == 0)
+			return 0;
+		return searchInternal(0, limit, 0);
+	}
+
+	u32 ExactCoverSolver::searchInternal(u32 depth, u32 limit, u32 numFound) {
+		auto& n = _matrix.nodes;
+
+		if (n[RootNode].right == RootNode) {
+			if (numFound == 0) {
+				memcpy(_solution, _partial, sizeof(u16) * depth);
+				_solutionSize = depth;
+			}
+			return 1;
+		}
+
+		// column with the fewest rows left gives the smallest branching factor
+		u16 column = n[RootNode].right;
+		for (u16 c = n[column].right; c != RootNode; c = n[c].right) {
+			if (_matrix.sizes[c] < _matrix.sizes[column])
+				column = c;
+		}
+
+		if (_matrix.sizes[column] == 0)
+			return 0;
+
+		u32 count = 0;
+		cover(column);
+		for (u16 r = n[column].down; r != column; r = n[r].down) {
+			_partial[depth] = n[r].row;
+			for (u16 j = n[r].right; j != r; j = n[j].right)
+				cover(n[j].column);
+
+			count += searchInternal(depth + 1, limit, numFound + count);
+
+			for (u16 j = n[r].left; j != r; j = n[j].left)
+				uncover(n[j].column);
+
+			if (numFound + count >= limit)
+				break;
+		}
+		uncover(column);
+
+		return count;
+	}
+
+	void ExactCoverSolver::writeSolution(Board& b) const {
+		for (u32 i = 0; i < _solutionSize; ++i) {
+			const u16 row = _solution[i];
+			b.Nodes[row / 9].solve(row % 9 + 1u);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+
+namespace ddahlkvist
+{
+	// Dancing links (Algorithm X) over the sudoku exact cover matrix.
+	// Columns: 81 cells + 81 row/value + 81 column/value + 81 block/value, rows: 81 cells * 9 values.
+	// All nodes live in fixed arrays, a solver starts out as a copy of a pristine matrix that is built once.
+	struct ExactCoverMatrix
+	{
+		static constexpr u32 NumColumns = 4 * BoardSize;
+		static constexpr u32 NumRows = 9 * BoardSize;
+		static constexpr u32 NumNodes = 1 + NumColumns + 4 * NumRows; // root + column headers + 4 nodes per row
+
+		struct Links {
+			u16 left;
+			u16 right;
+			u16 up;
+			u16 down;
+			u16 column;	// header node of the column this node belongs to
+			u16 row;	// nodeId * 9 + valueId
+		};
+
+		Links nodes[NumNodes];
+		u16 sizes[NumNodes];		// only used for column headers
+		bool covered[NumNodes];		// only used for column headers
+
+		static const ExactCoverMatrix& pristine();
+	};
+
+	class ExactCoverSolver
+	{
+	public:
+		ExactCoverSolver();
+
+		// covers the columns of every solved node in b, returns false if two givens conflict
+		bool loadGivens(const Board& b);
+
+		// uncovers everything loadGivens covered, bringing the solver back to the pristine matrix without copying it
+		void clearGivens();
+
+		// counts solutions, stops as soon as limit is reached, the first solution found can be written with writeSolution
+		u32 search(u32 limit);
+
+		void writeSolution(Board& b) const;
+
+	private:
+		void cover(u16 column);
+		void uncover(u16 column);
+		u32 searchInternal(u32 depth, u32 limit, u32 numFound);
+
+		ExactCoverMatrix _matrix;
+		u16 _givenColumns[ExactCoverMatrix::NumColumns];
+		u32 _numGivenColumns = 0;
+		u16 _partial[BoardSize];
+		u16 _solution[BoardSize];
+		u32 _solutionSize = 0;
+	};
+}
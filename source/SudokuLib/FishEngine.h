@@ -0,0 +1,134 @@
+#pragma once
+
+#include <bit>
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+#include <BoardUtils.h>
+#include <SubsetEngine.h>
+
+namespace ddahlkvist
+{
+	// Fish [X-Wing, Swordfish, Jellyfish] are found per candidate on 9-bit line masks, one mask per row and one per column.
+	// size base lines [rows] holding the candidate in only size cover lines [columns] --> the cover lines can drop the candidate outside the base lines.
+	// Finned: the base lines also hold the candidate inside one block [the fins], then only the cover nodes in that block can drop it.
+	namespace fish
+	{
+		constexpr uint MinSize = 2;
+		constexpr uint MaxSize = 4;
+
+		// rows[r] has bit c set if node [r, c] holds the candidate, columns[c] has bit r set for the same node
+		struct LineMasks {
+			u16 rows[9];
+			u16 columns[9];
+		};
+
+		inline LineMasks lineMasksOf(const BitBoard& candidates) {
+			LineMasks out{};
+			const u64 lower = candidates.word(0);
+			const u64 upper = candidates.word(1);
+			for (uint row = 0; row < 9; ++row) {
+				// row 7 [nodes 63-71] is split between the two words
+				const uint offset = row * 9;
+				const u64 bits = offset >= 64 ? upper >> (offset - 64) : (lower >> offset) | (offset + 9 > 64 ? upper << (64 - offset) : 0);
+				out.rows[row] = static_cast<u16>(bits & 0x1FF);
+				for (u32 column : SetBits<u16>(out.rows[row]))
+					out.columns[column] |= static_cast<u16>(1u << row);
+			}
+			return out;
+		}
+
+		namespace detail {
+			constexpr u16 AllLines = 0x1FF;
+			constexpr u16 BandMask = 0b111;
+
+			template<bool BaseIsRows>
+			constexpr u32 nodeIdOf(uint line, uint position) {
+				return BaseIsRows ? line * 9 + position : position * 9 + line;
+			}
+
+			// every node of the lines in lineIds that holds the candidate in one of the positions
+			template<bool BaseIsRows>
+			void addNodes(BitBoard& out, const u16 (&lines)[9], u16 lineIds, u16 positions) {
+				for (u32 line : SetBits<u16>(lineIds)) {
+					for (u32 position : SetBits<u16>(static_cast<u16>(lines[line] & positions)))
+						out.setBit(nodeIdOf<BaseIsRows>(line, position));
+				}
+			}
+
+			template<bool BaseIsRows>
+			BitBoard fishEliminations(const u16 (&lines)[9], uint size, bool finned) {
+				// fins share a band of positions with at least one cover line, so there are at most 2 of them [no cover line through the fin block, nothing to eliminate]
+				const u32 maxPositions = finned ? size + 2 : size;
+
+				// base lines hold the candidate in at least 2 positions [1 is a hidden single], without fins all of them must be covered
+				u16 eligibleLines[9];
+				u8 eligibleLineIds[9];
+				uint numEligible = 0;
+				for (uint line = 0; line < 9; ++line) {
+					const u32 numPositions = popCount16(lines[line]);
+					if (numPositions >= 2 && numPositions <= maxPositions) {
+						eligibleLines[numEligible] = lines[line];
+						eligibleLineIds[numEligible++] = static_cast<u8>(line);
+					}
+				}
+
+				BitBoard eliminations;
+				subsets::foreachSubsetOf(numEligible, size, [&](u16 members) {
+					u16 baseLines = 0;
+					u16 positions = 0;
+					for (u32 i : SetBits<u16>(members)) {
+						baseLines |= static_cast<u16>(1u << eligibleLineIds[i]);
+						positions |= eligibleLines[i];
+					}
+					const u16 otherLines = AllLines & ~baseLines;
+					const u32 numPositions = popCount16(positions);
+
+					if (!finned) {
+						if (numPositions == size)
+							addNodes<BaseIsRows>(eliminations, lines, otherLines, positions);
+						return;
+					}
+
+					if (numPositions <= size || numPositions > maxPositions)
+						return; // no fins [left to the plain fish] or too many
+
+					// the fins are confined to one band of positions, every position outside that band is a cover line
+					for (uint band = 0; band < 3; ++band) {
+						const u16 bandPositions = static_cast<u16>(BandMask << (band * 3));
+						const u32 numOutside = popCount16(static_cast<u16>(positions & ~bandPositions));
+						if (numOutside >= size)
+							continue;
+
+						const u16 inside = positions & bandPositions;
+						for (u16 coverInside = inside; coverInside != 0; coverInside = (coverInside - 1) & inside) {
+							if (numOutside + popCount16(coverInside) != size)
+								continue;
+
+							const u16 finPositions = inside & ~coverInside;
+							u16 finLines = 0;
+							for (u32 i : SetBits<u16>(members)) {
+								if (eligibleLines[i] & finPositions)
+									finLines |= static_cast<u16>(1u << eligibleLineIds[i]);
+							}
+
+							// ... and to one band of base lines, together that is one block
+							const u16 lineBand = static_cast<u16>(BandMask << (std::countr_zero(finLines) / 3 * 3));
+							if (finLines & ~lineBand)
+								continue;
+
+							addNodes<BaseIsRows>(eliminations, lines, otherLines & lineBand, coverInside);
+						}
+					}
+				});
+				return eliminations;
+			}
+		}
+
+		// nodes that can drop the candidate for every fish of the given size, with rows and with columns as base lines
+		inline BitBoard fishEliminations(const LineMasks& lines, uint size, bool finned) {
+			assert(size >= MinSize && size <= MaxSize);
+			return detail::fishEliminations<true>(lines.rows, size, finned) | detail::fishEliminations<false>(lines.columns, size, finned);
+		}
+	}
+}
@@ -3,7 +3,6 @@
 #include <algorithm>
 #include <array>
 #include <functional>
-#include <intrin.h>
 #include <map>
 #include <assert.h>
 
@@ -12,7 +11,7 @@
 
 namespace ddahlkvist
 {
-	enum class Techniques;
+	enum class Techniques : u8;
 	struct Result;
 
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include <Core/Types.h>
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+
+namespace ddahlkvist
+{
+	// 4 bits per node, 0 --> empty and 1-9 --> solved with that value. node i lives in byte i/2, even nodes in the low nibble
+	// the layout is the same in memory and on disk, a file of packed boards is just the records back to back
+	struct PackedBoard
+	{
+		static constexpr u32 NumBytes = (BoardSize + 1) / 2;
+		u8 nibbles[NumBytes];
+
+		u8 get(u32 nodeId) const {
+			const u8 byte = nibbles[nodeId / 2];
+			return nodeId % 2 == 0 ? (byte & 0x0F) : (byte >> 4);
+		}
+
+		void set(u32 nodeId, u8 value) {
+			u8& byte = nibbles[nodeId / 2];
+			byte = nodeId % 2 == 0 ? static_cast<u8>((byte & 0xF0) | value) : static_cast<u8>((byte & 0x0F) | (value << 4));
+		}
+
+		// every node is empty or 1-9, nibbles 10-15 can only come from corrupt or hostile bytes
+		bool isValid() const {
+			for (u32 i = 0; i < BoardSize; ++i) {
+				if (get(i) > 9)
+					return false;
+			}
+			return true;
+		}
+
+		bool operator==(const PackedBoard& other) const {
+			return memcmp(nibbles, other.nibbles, NumBytes) == 0;
+		}
+	};
+	static_assert(sizeof(PackedBoard) == 41, "PackedBoard is stored back to back on disk");
+
+	// only solved nodes are stored, candidates of unsolved nodes are lost
+	inline PackedBoard packBoard(const Board& b) {
+		PackedBoard packed = {};
+		for (u32 i = 0; i < BoardSize; ++i) {
+			const Node& node = b.Nodes[i];
+			if (node.isSolved())
+				packed.set(i, static_cast<u8>(node.getValue()));
+		}
+		return packed;
+	}
+
+	// returns false and leaves outBoard untouched if the packed board is not valid
+	inline bool unpackBoard(const PackedBoard& packed, Board& outBoard) {
+		if (!packed.isValid())
+			return false;
+
+		for (u32 i = 0; i < BoardSize; ++i) {
+			const u8 value = packed.get(i);
+			outBoard.Nodes[i] = Node();
+			if (value != 0)
+				outBoard.Nodes[i].solve(value);
+		}
+		return true;
+	}
+
+	// contiguous packed boards, either owned or a view over memory someone else keeps alive [a mapped file, a network buffer]
+	class BoardBatch
+	{
+	public:
+		BoardBatch() = default;
+
+		// zero-copy view, the memory must outlive the batch
+		explicit BoardBatch(std::span<const PackedBoard> view)
+			: _view(view)
+		{
+		}
+
+		// a copy of an owning batch views its own boards, a copy of a view shares the viewed memory
+		BoardBatch(const BoardBatch& other)
+			: _owned(other._owned)
+			, _view(other.isOwning() ? std::span<const PackedBoard>(_owned) : other._view)
+		{
+		}
+
+		BoardBatch(BoardBatch&& other) noexcept {
+			*this = std::move(other);
+		}
+
+		BoardBatch& operator=(const BoardBatch& other) {
+			if (this != &other) {
+				const bool owning = other.isOwning();
+				_owned = other._owned;
+				_view = owning ? std::span<const PackedBoard>(_owned) : other._view;
+			}
+			return *this;
+		}
+
+		BoardBatch& operator=(BoardBatch&& other) noexcept {
+			if (this != &other) {
+				const bool owning = other.isOwning();
+				const std::span<const PackedBoard> otherView = other._view;
+				_owned = std::move(other._owned);
+				_view = owning ? std::span<const PackedBoard>(_owned) : otherView;
+				other._owned.clear();
+				other._view = {};
+			}
+			return *this;
+		}
+
+		// view over raw bytes [a file, a network buffer], returns false if the size is not a whole number of boards or any node is not 0-9
+		static bool fromBytes(const void* data, u64 numBytes, BoardBatch& outBatch) {
+			if (numBytes % sizeof(PackedBoard) != 0)
+				return false;
+
+			const std::span<const PackedBoard> view(static_cast<const PackedBoard*>(data), numBytes / sizeof(PackedBoard));
+			for (const PackedBoard& packed : view) {
+				if (!packed.isValid())
+					return false;
+			}
+
+			outBatch = BoardBatch(view);
+			return true;
+		}
+
+		void reserve(u32 numBoards) { _owned.reserve(numBoards); }
+
+		void append(const PackedBoard& packed) {
+			assert(isOwning());
+			_owned.push_back(packed);
+			_view = _owned;
+		}
+
+		void append(const Board& b) { append(packBoard(b)); }
+
+		bool isOwning() const { return _view.empty() || _view.data() == _owned.data(); }
+		u32 size() const { return static_cast<u32>(_view.size()); }
+		const PackedBoard& operator[](u32 idx) const { return _view[idx]; }
+		std::span<const PackedBoard> boards() const { return _view; }
+
+		// bytes to write to disk or send, readable again through fromBytes
+		const void* data() const { return _view.data(); }
+		u64 sizeInBytes() const { return _view.size_bytes(); }
+
+	private:
+		std::vector<PackedBoard> _owned;
+		std::span<const PackedBoard> _view;
+	};
+}
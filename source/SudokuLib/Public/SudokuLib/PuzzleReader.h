@@ -0,0 +1,78 @@
+#pragma once
+
+#include <span>
+#include <string.h>
+
+#include <Core/Types.h>
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+
+namespace ddahlkvist
+{
+	// walks a text buffer with one puzzle per line, the first 81 characters of a line are the board
+	// lines starting with '#', lines shorter than a board and malformed boards are skipped, nothing is copied out of the buffer
+	class PuzzleTextReader
+	{
+	public:
+		PuzzleTextReader() = default;
+		PuzzleTextReader(const char* data, u64 size)
+			: _cursor(data)
+			, _end(data + size)
+		{
+		}
+
+		bool next(Board& outBoard) {
+			while (_cursor < _end) {
+				const char* line = _cursor;
+				const char* newline = static_cast<const char*>(memchr(line, '\n', static_cast<size_t>(_end - line)));
+				const char* lineEnd = newline != nullptr ? newline : _end;
+				_cursor = newline != nullptr ? newline + 1 : _end;
+
+				if (lineEnd > line && lineEnd[-1] == '\r')
+					lineEnd--;
+
+				if (lineEnd - line < static_cast<s64>(BoardSize) || line[0] == '#')
+					continue;
+
+				if (Board::tryFromString(line, outBoard))
+					return true;
+			}
+			return false;
+		}
+
+		// fills as many boards as possible, returns the number read [less than outBoards.size() only when the buffer is exhausted]
+		u32 read(std::span<Board> outBoards) {
+			u32 numRead = 0;
+			while (numRead < outBoards.size() && next(outBoards[numRead]))
+				numRead++;
+			return numRead;
+		}
+
+		bool isDone() const { return _cursor >= _end; }
+
+	private:
+		const char* _cursor = nullptr;
+		const char* _end = nullptr;
+	};
+
+	// read-only memory mapping of a puzzle file, the OS pages the file in as the reader walks it
+	class MappedPuzzleFile
+	{
+	public:
+		SUDOKULIB_PUBLIC explicit MappedPuzzleFile(const char* path);
+		SUDOKULIB_PUBLIC ~MappedPuzzleFile();
+
+		MappedPuzzleFile(const MappedPuzzleFile&) = delete;
+		MappedPuzzleFile& operator=(const MappedPuzzleFile&) = delete;
+
+		bool isOpen() const { return _data != nullptr; }
+		const char* data() const { return _data; }
+		u64 size() const { return _size; }
+		PuzzleTextReader reader() const { return PuzzleTextReader(_data, _size); }
+
+	private:
+		const char* _data = nullptr;
+		u64 _size = 0;
+		void* _handle = nullptr;
+	};
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include <SudokuLib/sudokulib_module.h>
 #include <SudokuLib/SudokuTypes.h>
 
@@ -84,11 +87,51 @@ namespace ddahlkvist::techniques
 
 	SUDOKULIB_PUBLIC bool removeXWing(SudokuContext& p);
 
+	// X-Wing, Swordfish and Jellyfish are fish of size 2-4 [FishEngine.h], the finned variant covers all three sizes
+	SUDOKULIB_PUBLIC bool removeSwordfish(SudokuContext& p);
+
+	SUDOKULIB_PUBLIC bool removeJellyfish(SudokuContext& p);
+
+	SUDOKULIB_PUBLIC bool removeFinnedFish(SudokuContext& p);
+
 	SUDOKULIB_PUBLIC bool removeYWing(SudokuContext& p);
 
 	SUDOKULIB_PUBLIC bool removeUniqueRectangle(SudokuContext& p);
 
 	using TechniqueFunction = std::function<bool(SudokuContext& p)>;
-	SUDOKULIB_PUBLIC std::vector<TechniqueFunction> allTechniques();
+
+	// Ordered list of techniques resolved at compile time, run() stops at the first technique that made progress.
+	// Custom orderings can be declared the same way as DefaultPipeline, note that with the DLL platform the technique addresses are not constant outside SudokuLib.
+	template<auto... TechniqueFunctions>
+	struct TechniquePipeline
+	{
+		static constexpr size_t Size = sizeof...(TechniqueFunctions);
+
+		static bool run(SudokuContext& p) {
+			return (TechniqueFunctions(p) || ...);
+		}
+
+		static std::vector<TechniqueFunction> asFunctions() {
+			return { TechniqueFunctions... };
+		}
+	};
+
+	using DefaultPipeline = TechniquePipeline<
+		removeNaiveCandidates,
+		removeNakedSingle, removeHiddenSingle,
+		removeNakedPair, removeNakedTriplet,
+		removeHiddenPair, removeHiddenTriplet,
+		removeNakedQuad, removeHiddenQuad,
+		removePointingPair,
+		removeBoxLineReduction,
+		removeXWing, removeYWing,
+		removeSingleChain,
+		removeUniqueRectangle,
+		removeSwordfish, removeJellyfish,
+		removeFinnedFish
+	>;
+
+	// same ordering as DefaultPipeline, for callers that need to pick techniques at runtime
+	SUDOKULIB_PUBLIC const std::vector<TechniqueFunction>& allTechniques();
 	
 } // techniques
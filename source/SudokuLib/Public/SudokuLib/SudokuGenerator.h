@@ -0,0 +1,39 @@
+#pragma once
+
+#include <span>
+
+#include <Core/Types.h>
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+#include <SudokuLib/TechniqueMeta.h>
+
+namespace ddahlkvist
+{
+	struct GeneratorOptions
+	{
+		u64 seed = 0;									// puzzle i is generated from (seed, i) so output does not depend on thread count
+		u32 numThreads = 0;								// 0 --> one worker per hardware thread
+		Techniques minTechnique = Techniques::None;		// hardest technique needed to solve the puzzle must be in [minTechnique, maxTechnique] by difficultyRank
+		Techniques maxTechnique = Techniques::Backtracking;
+		u32 maxAttemptsPerPuzzle = 1000;				// full grids tried per puzzle before giving up on the difficulty target
+	};
+
+	struct GeneratorStats
+	{
+		u32 numGenerated = 0;
+		u32 numAttempts = 0;
+		double seconds = 0.0;
+		double puzzlesPerSecond = 0.0;
+	};
+
+	// random completely solved grid
+	SUDOKULIB_PUBLIC Board generateFullGrid(u64 seed);
+
+	// removes clues from the grid in random order as long as the puzzle keeps a unique solution, the result is minimal
+	// [removing any remaining clue would give more than one solution]
+	SUDOKULIB_PUBLIC Board removeCluesMinimal(const Board& fullGrid, u64 seed);
+
+	// fills every board with a minimal, uniquely solvable puzzle within the difficulty target, spread over a work-stealing pool of workers
+	// boards that missed the target within maxAttemptsPerPuzzle are left empty and are not counted in numGenerated
+	SUDOKULIB_PUBLIC GeneratorStats generatePuzzles(std::span<Board> outBoards, const GeneratorOptions& options = {});
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <span>
+
+#include <Core/Types.h>
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+#include <SudokuLib/TechniqueMeta.h>
+
+namespace ddahlkvist
+{
+	// score of a board = sum over every iteration that made progress: perUse[technique] + perNode[technique] * nodesChanged
+	struct RatingWeights
+	{
+		float perUse[NumTechniques] = {};
+		float perNode[NumTechniques] = {};
+
+		SUDOKULIB_PUBLIC static RatingWeights defaults();
+	};
+
+	struct BoardRating
+	{
+		float score = 0.f;
+		Techniques hardest = Techniques::None;
+		u32 numIterations = 0;
+		bool solved = false;
+	};
+
+	// aggregated over any number of rated chunks, so a corpus can be streamed through rateBoards in pieces
+	struct RatingSummary
+	{
+		u32 numRated = 0;
+		u32 numSolved = 0;
+		double totalScore = 0.0;
+		float maxScore = 0.f;
+		u32 numWithHardest[NumTechniques] = {};
+
+		void add(const BoardRating& rating) {
+			numRated++;
+			numSolved += rating.solved;
+			totalScore += rating.score;
+			maxScore = rating.score > maxScore ? rating.score : maxScore;
+			numWithHardest[static_cast<u32>(rating.hardest)]++;
+		}
+
+		void add(const RatingSummary& other) {
+			numRated += other.numRated;
+			numSolved += other.numSolved;
+			totalScore += other.totalScore;
+			maxScore = other.maxScore > maxScore ? other.maxScore : maxScore;
+			for (u32 i = 0; i < NumTechniques; ++i)
+				numWithHardest[i] += other.numWithHardest[i];
+		}
+
+		double meanScore() const { return numRated > 0 ? totalScore / numRated : 0.0; }
+	};
+
+	struct RatingOptions
+	{
+		RatingWeights weights = RatingWeights::defaults();
+		u32 numThreads = 0;		// 0 --> one worker per hardware thread
+		u32 chunkSize = 16;
+	};
+
+	SUDOKULIB_PUBLIC BoardRating rateLedger(const SolveLedger& ledger, bool solved, const RatingWeights& weights);
+
+	// solves a copy of the board with the explainable solver and rates its ledger, scratch is overwritten
+	SUDOKULIB_PUBLIC BoardRating rateBoard(const Board& b, Result& scratch, const RatingWeights& weights);
+
+	// rates every board in parallel, outRatings must be the same size as boards, returns the summary of this chunk
+	SUDOKULIB_PUBLIC RatingSummary rateBoards(std::span<const Board> boards, std::span<BoardRating> outRatings, const RatingOptions& options = {});
+}
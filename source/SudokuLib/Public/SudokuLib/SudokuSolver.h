@@ -0,0 +1,116 @@
+#pragma once
+
+#include <span>
+
+#include <Core/Types.h>
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+#include <SudokuLib/SudokuAlgorithm.h>
+#include <SudokuLib/BoardBatch.h>
+#include <SudokuLib/TechniqueMeta.h>
+
+namespace ddahlkvist
+{
+	enum class SolveMode {
+		Explainable,	// human style techniques, every step is recorded in the result ledger
+		RawThroughput,	// exact cover search, only the answer is produced and the ledger is left empty
+		CandidateMajor,	// singles, locked candidates, subsets and fish on per-digit bitboards only, no per-node state until the answer is written, the ledger is left empty
+	};
+
+	struct BatchOptions
+	{
+		SolveMode mode = SolveMode::Explainable;
+		u32 numThreads = 0;		// 0 --> one worker per hardware thread
+		u32 chunkSize = 16;		// boards claimed at a time by a worker, stealing always takes half of what is left on a victim
+	};
+
+	struct BatchOutcome
+	{
+		u32 numBoards = 0;
+		u32 numSolved = 0;
+	};
+
+	using PropagateFunction = bool(*)(SudokuContext& p);
+
+	// guess-and-propagate search for boards the techniques cannot finish, branches on the node with the fewest candidates and uses propagate to deduce the rest
+	// returns true with the board solved, or false with the board restored if it has no solution
+	SUDOKULIB_PUBLIC bool searchBoard(SudokuContext& p, PropagateFunction propagate);
+
+	// runs the techniques of Pipeline on the board until none of them make any progress, then falls back to searchBoard
+	// returns true if all nodes got solved
+	template<typename Pipeline>
+	bool solveBoardWithPipeline(Board& b, Result& r) {
+		// do an early iteration to fill candidates and remove the known nodes (from neighbouring solved nodes)
+		{
+			SudokuContext context = buildContext(b, r);
+			techniques::fillUnsolvedWithNonNaiveCandidates(context);
+		}
+
+		SolveLedger& ledger = r.ledger;
+		u32 iteration = 0;
+
+		// built once, then kept in sync with the nodes each technique touched
+		SudokuContext context = buildContext(b, r);
+
+#ifdef DD_DEBUG
+		BoardText debugText; // inspect in the debugger to see the board at the start of each iteration
+#endif
+
+		bool iterateAgain = true;
+		while (iterateAgain && iteration < ledger.MaxEntries) {
+#ifdef DD_DEBUG
+			debugText.updateDebugPretty(b);
+#endif
+			r.reset();
+			const bool progressed = context.Unsolved == BitBoard{} || Pipeline::run(context);
+			ledger.numNodesChangedInIteration[iteration] = progressed ? static_cast<u8>(r.size()) : 0u;
+			ledger.techniqueUsedInIteration[iteration] = progressed ? r.Technique : Techniques::None;
+
+			updateContext(context, r.changedNodes());
+			iteration++;
+			iterateAgain = r.size() != 0;
+		}
+
+		// the techniques are stuck, finish the board by searching [using the same techniques to propagate each guess]
+		if (context.Unsolved != BitBoard{} && iteration < ledger.MaxEntries) {
+			const u8 numUnsolved = context.Unsolved.countSetBits();
+			if (searchBoard(context, &Pipeline::run)) {
+				ledger.numNodesChangedInIteration[iteration] = numUnsolved;
+				ledger.techniqueUsedInIteration[iteration] = Techniques::Backtracking;
+				iteration++;
+			}
+		}
+		ledger.numIterations = iteration;
+
+		return context.Unsolved == BitBoard{};
+	}
+
+	// solveBoardWithPipeline using techniques::DefaultPipeline
+	SUDOKULIB_PUBLIC bool solveBoard(Board& b, Result& r);
+
+	// solves the board with the dancing links exact cover backend, no techniques are run and the ledger is left empty
+	SUDOKULIB_PUBLIC bool solveBoardExactCover(Board& b, Result& r);
+
+	// solves the board on a candidate-major state [nine candidate and nine solved bitboards], the board is only written once solved
+	// the bitboard techniques run on that state directly, nothing is recorded, use solveBoard for the technique ledger
+	SUDOKULIB_PUBLIC bool solveBoardCandidateMajor(Board& b, Result& r);
+
+	SUDOKULIB_PUBLIC bool solveBoard(Board& b, Result& r, SolveMode mode);
+
+	// counts the solutions of the board with the exact cover backend, stops as soon as limit solutions are found
+	SUDOKULIB_PUBLIC u32 countSolutions(const Board& b, u32 limit);
+
+	// true if the board has exactly one solution, stops searching at the second one
+	SUDOKULIB_PUBLIC bool hasUniqueSolution(const Board& b);
+
+	// hardest technique that made progress while solving [by difficultyRank]
+	SUDOKULIB_PUBLIC Techniques hardestTechnique(const SolveLedger& ledger);
+
+	// solves every board in place, spread over a work-stealing pool of workers
+	// if results is not empty it must be the same size as boards and receives the result of each board, otherwise a per-worker scratch result is used
+	SUDOKULIB_PUBLIC BatchOutcome solveBatch(std::span<Board> boards, const BatchOptions& options = {}, std::span<Result> results = {});
+
+	// solves the packed boards without expanding the batch, each worker unpacks one board at a time into its own scratch board
+	// if solutions is not empty it must be the same size as the batch and receives the packed solved boards [an empty board for boards that fail PackedBoard::isValid]
+	SUDOKULIB_PUBLIC BatchOutcome solveBatch(const BoardBatch& batch, std::span<PackedBoard> solutions, const BatchOptions& options = {});
+}
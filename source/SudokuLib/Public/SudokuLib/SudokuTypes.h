@@ -3,16 +3,22 @@
 #include <algorithm>
 #include <array>
 #include <functional>
-#include <intrin.h>
 #include <map>
+#include <type_traits>
 #include <assert.h>
 
+#include <emmintrin.h>
+
+// define DD_BITBOARD_SSE to run BitBoard operations through __m128i instead of two scalar words
+// [off by default, DD_BITBOARD_SSE measured ~5% slower on the example boards, the compiler already pairs the scalar words]
+
+#include <Core/BitOps.h>
 #include <Core/Types.h>
 #include <SudokuLib/sudokulib_module.h>
 
 namespace ddahlkvist
 {
-	enum class Techniques;
+	enum class Techniques : u8;
 	struct Result;
 
 	constexpr uint BoardSize = 81u;
@@ -102,23 +108,54 @@ namespace ddahlkvist
 		#pragma warning(pop)
 	};
 
+	// hot solver state only, 162 bytes that are copied whenever a board is snapshotted
 	struct Board
 	{
-		static constexpr u8 MaxPrettyChars = 142;
 		Node Nodes[BoardSize];
+
+		//Node& begin() { return Nodes[0]; }
+		//Node& end() { return Nodes[81]; }
+
+		bool operator==(const Board& other) const
+		{
+			for (uint i = 0; i < BoardSize; ++i)
+			{
+				if ((Nodes[i] == other.Nodes[i]) == false)
+					return false;
+			}
+			return true;
+		}
+
+		bool operator!=(const Board& other) const
+		{
+			return (*this == other) == false;
+		}
+
+		// characters '1'-'9' are givens, '.', 'x', ' ' and '0' are empty nodes and any other character is read as an empty node
+		SUDOKULIB_PUBLIC static Board fromString(const char* data);
+
+		// same as fromString but rejects input with any character that is neither a digit nor an empty marker, outBoard is left untouched then
+		SUDOKULIB_PUBLIC static bool tryFromString(const char* data, Board& outBoard);
+	};
+	static_assert(sizeof(Board) == sizeof(Node) * BoardSize);
+
+	// cold text side of a board, only built when the board is printed or inspected in a debugger
+	struct BoardText
+	{
+		static constexpr u8 MaxPrettyChars = 142;
 		char raw[BoardSize];
 		char pretty[MaxPrettyChars];
 
-		void updateDebugPretty() {
-			auto nodeToChar = [](Node& n) -> char {
-				if (n.isSolved()) {
-					return '0' + static_cast<char>(n.getValue());
-				}
-				else {
-					return '.';
-				}
-			};
+		BoardText() = default;
+		explicit BoardText(const Board& b) { update(b); }
+
+		void update(const Board& b) {
+			for (uint i = 0; i < BoardSize; ++i)
+				raw[i] = nodeToChar(b.Nodes[i]);
+			updateDebugPretty(b);
+		}
 
+		void updateDebugPretty(const Board& b) {
 			uint p = 0;
 			for (uint i = 0; i < BoardSize; ++i, ++p) {
 				if (i % 27 == 0) {
@@ -135,84 +172,32 @@ namespace ddahlkvist
 					pretty[p++] = '\n';
 				} else if (i % 3 == 0)
 					pretty[p++] = '|';
-				pretty[p] = nodeToChar(Nodes[i]);
+				pretty[p] = nodeToChar(b.Nodes[i]);
 			}
 			pretty[p] = '|';
 			assert(p < MaxPrettyChars);
 		}
 
-		Board() = default;
-
-		Board(const Board& other)
-		{
-			memcpy(this->raw, &other.raw[0], sizeof(char) * BoardSize);
-			memcpy(this->Nodes, &other.Nodes[0], sizeof(Node) * BoardSize);
-		}
-
-		void operator=(const Board& other)
-		{
-			memcpy(this->raw, &other.raw[0], sizeof(char) * BoardSize);
-			memcpy(this->Nodes, &other.Nodes[0], sizeof(Node) * BoardSize);
-		}
-
-		//Node& begin() { return Nodes[0]; }
-		//Node& end() { return Nodes[81]; }
-
-		bool operator==(const Board& other) const
-		{
-			for (uint i = 0; i < BoardSize; ++i)
-			{
-				if ((Nodes[i] == other.Nodes[i]) == false)
-					return false;
-				if (raw[i] != other.raw[i])
-					return false;
+	private:
+		static char nodeToChar(const Node& n) {
+			if (n.isSolved()) {
+				return '0' + static_cast<char>(n.getValue());
 			}
-			return true;
-		}
-
-		bool operator!=(const Board& other) const
-		{
-			return (*this == other) == false;
-		}
-
-		static Board fromString(const char* data) {
-			auto charToNode = [](char c) -> Node {
-				Node n;
-				switch (c)
-				{
-				case '.':
-				case 'x':
-				case ' ':
-				case '0':
-					break;
-				case '1':
-				case '2':
-				case '3':
-				case '4':
-				case '5':
-				case '6':
-				case '7':
-				case '8':
-				case '9':
-					u16 value = c - '0';
-					n.solve(value);
-					break;
-				}
-				return n;
-			};
-
-			Board b;
-			for (uint i = 0; i < BoardSize; ++i)
-			{
-				b.raw[i] = data[i];
-				b.Nodes[i] = charToNode(data[i]);
+			else {
+				return '.';
 			}
-
-			return b;
 		}
 	};
 
-	struct BitBoard
+	struct BitBoard;
+
+	// BitBoard::fillSetBits/countSetBits at runtime, point at the best kernels for the cpu once SudokuLib has been initialized [BitKernels.h]
+	using FillSetBitsKernel = u8 (*)(const BitBoard& board, u8* __restrict outNodeIds);
+	using CountSetBitsKernel = u8 (*)(const BitBoard& board);
+	SUDOKULIB_PUBLIC extern FillSetBitsKernel ActiveFillSetBits;
+	SUDOKULIB_PUBLIC extern CountSetBitsKernel ActiveCountSetBits;
+
+	struct alignas(16) BitBoard
 	{
 	private:
 		u64 bits[2];
@@ -227,6 +212,10 @@ namespace ddahlkvist
 		constexpr BitBoard() : BitBoard(None{}) {}
 		constexpr BitBoard(u64 lower, u64 upper) : bits{ lower, upper } {}
 
+		explicit BitBoard(__m128i value) { _mm_store_si128(reinterpret_cast<__m128i*>(bits), value); }
+		__m128i asVector() const { return _mm_load_si128(reinterpret_cast<const __m128i*>(bits)); }
+		constexpr u64 word(uint idx) const { return bits[idx]; } // idx 0 --> nodes 0-63, idx 1 --> nodes 64-80
+
 		void modifyBit(uint bitIndex, bool flag) {
 			if (flag)
 				setBit(bitIndex);
@@ -234,7 +223,7 @@ namespace ddahlkvist
 				clearBit(bitIndex);
 		}
 
-		void setBit(uint bitIndex) {
+		constexpr void setBit(uint bitIndex) {
 #ifdef VALIDATE_BIT_BOUNDS
 			assert(bitIndex < BoardSize);
 #endif
@@ -252,7 +241,7 @@ namespace ddahlkvist
 			bits[arrIdx] &= ~(1ULL << bitIndex);
 		}
 
-		bool test(uint bitIndex) const {
+		constexpr bool test(uint bitIndex) const {
 			const u8 arrIdx = bitIndex >= 64 ? 1 : 0;
 			bitIndex = bitIndex % 64;
 			const u64 with2nodes = 1ULL << bitIndex;
@@ -262,9 +251,9 @@ namespace ddahlkvist
 
 		u8 firstOne() const {
 			u32 value;
-			if (!_BitScanForward64(&value, bits[0]))
+			if (!bitScanForward64(value, bits[0]))
 			{
-				if (!_BitScanForward64(&value, bits[1]))
+				if (!bitScanForward64(value, bits[1]))
 					return 128;
 				else
 					value += 64;
@@ -273,33 +262,28 @@ namespace ddahlkvist
 		}
 
 		constexpr inline u8 fillSetBits(u8* __restrict bitArr) const {
-			u8* dest = bitArr;
-
-			u64 word1 = bits[0];
-			u64 word2 = bits[1];
-
-			for (u8 i = 0u; word1 != 0u; ++i) {
-				*dest = i;
-				dest += word1 & u64(1u);
-				word1 >>= 1u;
-			}
+			if (!std::is_constant_evaluated())
+				return ActiveFillSetBits(*this, bitArr);
+			return fillSetBitsPortable(bitArr);
+		}
 
-			for (u8 i = 64; word2 != 0u; ++i) {
-				*dest = i;
-				dest += word2 & u64(1u);
-				word2 >>= 1u;
+		// one iteration per set bit [trailing zero count + clear lowest], no instruction set requirements and usable in constant evaluation
+		constexpr inline u8 fillSetBitsPortable(u8* __restrict bitArr) const {
+			u8* dest = bitArr;
+			for (u32 w = 0; w < 2; ++w) {
+				for (u64 word = bits[w]; word != 0u; word = clearLowestSetBit(word))
+					*dest++ = static_cast<u8>(w * 64 + trailingZeros64(word));
 			}
-
 			return static_cast<u8>(dest - bitArr);
 		}
 
+		// visits the bits set when the call is made, action may modify the board
 		template<typename BitAction>
 		void foreachSetBit(BitAction&& action) const {
-			u8 bitArr[BoardSize + 1]; // need one extra for overwrite protection #todo : write test if this is necessary
-
-			const u8 end = fillSetBits(bitArr);
-			for (u8 i = 0; i < end; ++i) {
-				action(bitArr[i]);
+			const u64 words[2] = { bits[0], bits[1] };
+			for (u32 w = 0; w < 2; ++w) {
+				for (u32 bitIndex : SetBits<u64>(words[w]))
+					action(static_cast<u8>(w * 64 + bitIndex));
 			}
 		}
 
@@ -307,26 +291,47 @@ namespace ddahlkvist
 			return (bits[0] | bits[1]) != 0;
 		}
 
+		// inline when the build targets popcnt, otherwise the kernel picked at startup uses it if the cpu has it [BitKernels.h]
 		u8 countSetBits() const {
-			u64 numSetBits = __popcnt64(bits[0]);
-			numSetBits += __popcnt64(bits[1]);
+#if defined(__POPCNT__)
+			return countSetBitsPortable();
+#else
+			return ActiveCountSetBits(*this);
+#endif
+		}
+
+		u8 countSetBitsPortable() const {
+			u32 numSetBits = popCount64(bits[0]);
+			numSetBits += popCount64(bits[1]);
 			return static_cast<u8>(numSetBits);
 		}
 
 		bool operator==(const BitBoard& other) const
 		{
+#if defined(DD_BITBOARD_SSE)
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(asVector(), other.asVector())) == 0xFFFF;
+#else
 			return other.bits[0] == this->bits[0] && other.bits[1] == this->bits[1];
+#endif
 		}
 
 		BitBoard invert() const {
+#if defined(DD_BITBOARD_SSE)
+			return BitBoard(_mm_xor_si128(asVector(), BitBoard(All{}).asVector()));
+#else
 			BitBoard inverted;
 			inverted.bits[0] = ~bits[0];
 			inverted.bits[1] = ~bits[1];
 			inverted.bits[1] &= UpperMask;
 			return inverted;
+#endif
 		}
 
 		constexpr BitBoard operator&(const BitBoard& other) const {
+#if defined(DD_BITBOARD_SSE)
+			if (!std::is_constant_evaluated())
+				return BitBoard(_mm_and_si128(asVector(), other.asVector()));
+#endif
 			BitBoard out;
 			out.bits[0] = this->bits[0] & other.bits[0];
 			out.bits[1] = this->bits[1] & other.bits[1];
@@ -334,6 +339,10 @@ namespace ddahlkvist
 		}
 
 		constexpr BitBoard operator|(const BitBoard& other) const {
+#if defined(DD_BITBOARD_SSE)
+			if (!std::is_constant_evaluated())
+				return BitBoard(_mm_or_si128(asVector(), other.asVector()));
+#endif
 			BitBoard out;
 			out.bits[0] = this->bits[0] | other.bits[0];
 			out.bits[1] = this->bits[1] | other.bits[1];
@@ -341,6 +350,10 @@ namespace ddahlkvist
 		}
 
 		constexpr BitBoard operator^(const BitBoard& other) const {
+#if defined(DD_BITBOARD_SSE)
+			if (!std::is_constant_evaluated())
+				return BitBoard(_mm_xor_si128(asVector(), other.asVector()));
+#endif
 			BitBoard out;
 			out.bits[0] = this->bits[0] ^ other.bits[0];
 			out.bits[1] = this->bits[1] ^ other.bits[1];
@@ -348,16 +361,34 @@ namespace ddahlkvist
 		}
 
 		constexpr void operator|=(const BitBoard& other) {
+#if defined(DD_BITBOARD_SSE)
+			if (!std::is_constant_evaluated()) {
+				_mm_store_si128(reinterpret_cast<__m128i*>(bits), _mm_or_si128(asVector(), other.asVector()));
+				return;
+			}
+#endif
 			this->bits[0] |= other.bits[0];
 			this->bits[1] |= other.bits[1];
 		}
 
 		constexpr void operator&=(const BitBoard& other) {
+#if defined(DD_BITBOARD_SSE)
+			if (!std::is_constant_evaluated()) {
+				_mm_store_si128(reinterpret_cast<__m128i*>(bits), _mm_and_si128(asVector(), other.asVector()));
+				return;
+			}
+#endif
 			this->bits[0] &= other.bits[0];
 			this->bits[1] &= other.bits[1];
 		}
 
 		constexpr void operator^=(const BitBoard& other) {
+#if defined(DD_BITBOARD_SSE)
+			if (!std::is_constant_evaluated()) {
+				_mm_store_si128(reinterpret_cast<__m128i*>(bits), _mm_xor_si128(asVector(), other.asVector()));
+				return;
+			}
+#endif
 			this->bits[0] ^= other.bits[0];
 			this->bits[1] ^= other.bits[1];
 		}
@@ -368,6 +399,7 @@ namespace ddahlkvist
 		u8 index;
 		Node prev;
 	};
+	static_assert(sizeof(Change) == 4, "Change is copied into every change log and search trail");
 
 	namespace BoardBits {
 		using SudokuBitBoard = BitBoard;
@@ -376,6 +408,16 @@ namespace ddahlkvist
 		using BitBoards27 = std::array<SudokuBitBoard, 27>; // for instance all different rows
 	}
 
+	struct ParsedBoardMasks
+	{
+		BitBoard solved;
+		BoardBits::BitBoards9 values;	// values[0] --> nodes given as '1'
+		BitBoard malformed;				// nodes that are neither a digit nor an empty marker
+	};
+
+	// classifies all 81 characters with SIMD compares, returns false if any character is malformed
+	SUDOKULIB_PUBLIC bool parseBoardMasks(const char* data, ParsedBoardMasks& outMasks);
+
 	template<typename PtrType>
 	struct Span {
 		Span(const PtrType* firstElement, u32 count)
@@ -395,79 +437,84 @@ namespace ddahlkvist
 	struct SudokuContext {
 		Board& b;
 		Result& result;
+		const BoardBits::BitBoards27& AllDimensions; // the compile time unit table [BoardBits::Units], rows 0-8, columns 9-17, blocks 18-26
 
-		BoardBits::BitBoards9 SolvedValues;
+		BoardBits::BitBoards9 SolvedValues{};
 
-		BitBoard Solved;		// TODO: Remove
-		BitBoard Unsolved;	// TODO: Remove
-		BoardBits::BitBoards9 AllCandidates;
-		BoardBits::BitBoards27 AllDimensions;
-		inline Span<BitBoard> getBlocks() { return Span<BitBoard>(&AllDimensions[18], 9); }
+		BitBoard Solved{};		// TODO: Remove
+		BitBoard Unsolved{};	// TODO: Remove
+		BitBoard PendingSolved{};	// solved nodes whose value has not been removed from their peers yet, removeNaiveCandidates drains it
+		BoardBits::BitBoards9 AllCandidates{};
+		inline Span<BitBoard> getBlocks() const { return Span<BitBoard>(&AllDimensions[18], 9); }
 	};
 
+	// entries past numIterations are left uninitialized, copies and resets only touch the recorded iterations
 	struct SolveLedger
 	{
 		static constexpr u32 MaxEntries = 1000;
-		
+
+		SolveLedger() = default;
+		SolveLedger(const SolveLedger& other) { *this = other; }
+
+		SolveLedger& operator=(const SolveLedger& other) {
+			numIterations = other.numIterations;
+			std::copy_n(other.techniqueUsedInIteration, numIterations, techniqueUsedInIteration);
+			std::copy_n(other.numNodesChangedInIteration, numIterations, numNodesChangedInIteration);
+			return *this;
+		}
+
 		u32 numIterations = 0;
 
-		Techniques techniqueUsedInIteration[MaxEntries] = {};
-		u8 numNodesChangedInIteration[MaxEntries] = {};
+		Techniques techniqueUsedInIteration[MaxEntries];
+		u8 numNodesChangedInIteration[MaxEntries];
 	};
 
 	struct Result
 	{
+		Result() = default;
+		Result(const Result& other) { *this = other; }
+
+		// only the recorded changes are copied
+		Result& operator=(const Result& other) {
+			Technique = other.Technique;
+			ledger = other.ledger;
+			_dirty = other._dirty;
+			_numChanges = other._numChanges;
+			std::copy_n(other._changes, _numChanges, _changes);
+			return *this;
+		}
+
 		void storePreModification(const Node* nodes, const BitBoard& affectedNodes)
 		{
-			BitBoard newDirty = (affectedNodes ^ _dirty) & affectedNodes;
+			const BitBoard newDirty = (affectedNodes ^ _dirty) & affectedNodes;
 			_dirty |= affectedNodes;
 
-#ifdef DD_FINAL
-			newDirty.foreachSetBit([&](u32 bitIndex) {
-				ChangeCount++;
+			newDirty.foreachSetBit([this, nodes](u32 bitIndex) {
+				_changes[_numChanges++] = Change{ static_cast<u8>(bitIndex), nodes[bitIndex] };
 			});
-#else
-			newDirty.foreachSetBit([nodes, &Changes = Changes](u32 bitIndex) {
-				Changes.push_back({ static_cast<u8>(bitIndex), nodes[bitIndex] });
-			});
-#endif
 		}
 
 		void append(Node old, u8 id)
 		{
-			if (!_dirty.test(id))
-#ifdef DD_FINAL
-				ChangeCount++;
-#else
-				Changes.push_back({ id, old });
-#endif
-
+			if (!_dirty.test(id)) {
+				_dirty.setBit(id);
+				_changes[_numChanges++] = Change{ id, old };
+			}
 		}
 
-		Change fetch(uint idx)
+		Change fetch(uint idx) const
 		{
-#ifdef DD_FINAL
-			return Change{}; // dunno only used in teset?
-#else
-			return Changes[idx];
-#endif
-
+			assert(idx < _numChanges);
+			return _changes[idx];
 		}
 
-		uint size() {
-#ifdef DD_FINAL
-			return ChangeCount;
-#else
-			return static_cast<uint>(Changes.size());
-#endif
-		}
+		// all nodes modified since last reset, used to keep a SudokuContext up to date without rebuilding it
+		const BitBoard& changedNodes() const { return _dirty; }
+
+		uint size() const { return _numChanges; }
 
 		void reset() {
-#ifdef DD_FINAL
-			ChangeCount = 0;
-#else
-			Changes.clear();
-#endif
+			_numChanges = 0;
 			_dirty = {};
 			Technique = {};
 		}
@@ -475,11 +522,9 @@ namespace ddahlkvist
 		Techniques Technique{ };
 		SolveLedger ledger;
 	private:
-#ifdef DD_FINAL
-		u32 ChangeCount = 0;
-#else
-		std::vector<Change> Changes;
-#endif
+		// a node is only recorded the first time it changes after a reset [_dirty], so one entry per node is enough and nothing is ever allocated
+		Change _changes[BoardSize];
+		u8 _numChanges = 0;
 		BitBoard _dirty;
 	};
 
@@ -488,4 +533,7 @@ namespace ddahlkvist
 namespace ddahlkvist
 {
 	SUDOKULIB_PUBLIC SudokuContext buildContext(Board& b, Result& r);
+
+	// refresh the bitboards of a context for the nodes that changed since it was built, cost scales with number of changed nodes
+	SUDOKULIB_PUBLIC void updateContext(SudokuContext& ctx, const BitBoard& changedNodes);
 }
\ No newline at end of file
@@ -9,7 +9,7 @@ namespace ddahlkvist
 {
 	struct SudokuContext;
 
-	enum class Techniques {
+	enum class Techniques : u8 {
 		None = 0,
 		NaiveCandidates,
 		NakedSingle,
@@ -26,6 +26,50 @@ namespace ddahlkvist
 		Y_Wing,
 		SingleChain,
 		UniqueRectangle,
+		Swordfish,
+		Jellyfish,
+		FinnedFish, // finned X-Wing, Swordfish and Jellyfish
+		Backtracking, // not a logical technique, guess-and-propagate search used when all techniques are stuck [keep last]
 	};
 
+	constexpr u32 NumTechniques = static_cast<u32>(Techniques::Backtracking) + 1;
+
+	// difficulty from easiest to hardest, the enum keeps the order techniques were added in [use this to compare how hard techniques are]
+	constexpr u8 difficultyRank(Techniques technique) {
+		switch (technique) {
+		case Techniques::None:				return 0;
+		case Techniques::NaiveCandidates:	return 1;
+		case Techniques::NakedSingle:		return 2;
+		case Techniques::HiddenSingle:		return 3;
+		case Techniques::PointingPair:		return 4;
+		case Techniques::BoxLineReduction:	return 5;
+		case Techniques::NakedPair:			return 6;
+		case Techniques::HiddenPair:		return 7;
+		case Techniques::NakedTriplet:		return 8;
+		case Techniques::HiddenTriplet:		return 9;
+		case Techniques::NakedQuad:			return 10;
+		case Techniques::HiddenQuad:		return 11;
+		case Techniques::X_Wing:			return 12;
+		case Techniques::Y_Wing:			return 13;
+		case Techniques::SingleChain:		return 14;
+		case Techniques::UniqueRectangle:	return 15;
+		case Techniques::Swordfish:			return 16;
+		case Techniques::Jellyfish:			return 17;
+		case Techniques::FinnedFish:		return 18;
+		case Techniques::Backtracking:		return 19;
+		}
+		return 0;
+	}
+
+	constexpr Techniques harderOf(Techniques a, Techniques b) {
+		return difficultyRank(b) > difficultyRank(a) ? b : a;
+	}
+
+	// true if technique is within [easiest, hardest] by difficulty
+	constexpr bool isWithinDifficulty(Techniques technique, Techniques easiest, Techniques hardest) {
+		return difficultyRank(technique) >= difficultyRank(easiest) && difficultyRank(technique) <= difficultyRank(hardest);
+	}
+
+	static_assert(difficultyRank(Techniques::Backtracking) == NumTechniques - 1, "every technique needs its own rank");
+
 }
\ No newline at end of file
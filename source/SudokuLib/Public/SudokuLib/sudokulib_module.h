@@ -3,7 +3,9 @@
 namespace ddahlkvist
 {
 
+#if defined(_MSC_VER)
 #define MSVC_COMPILER 1
+#endif
 
 #if defined(MSVC_COMPILER)
 #define IMPORT_DLL __declspec(dllimport)
@@ -0,0 +1,99 @@
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/PuzzleReader.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ddahlkvist
+{
+	// an empty file cannot be mapped, it is still a valid file without puzzles
+	static const char EmptyFile[1] = {};
+
+#if defined(_WIN32)
+	MappedPuzzleFile::MappedPuzzleFile(const char* path) {
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize)) {
+			CloseHandle(file);
+			return;
+		}
+
+		if (fileSize.QuadPart == 0) {
+			CloseHandle(file);
+			_data = EmptyFile;
+			return;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping == nullptr)
+			return;
+
+		const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr) {
+			CloseHandle(mapping);
+			return;
+		}
+
+		_data = static_cast<const char*>(view);
+		_size = static_cast<u64>(fileSize.QuadPart);
+		_handle = mapping;
+	}
+
+	MappedPuzzleFile::~MappedPuzzleFile() {
+		if (_handle == nullptr)
+			return;
+
+		UnmapViewOfFile(_data);
+		CloseHandle(static_cast<HANDLE>(_handle));
+	}
+#else
+	MappedPuzzleFile::MappedPuzzleFile(const char* path) {
+		const int fd = open(path, O_RDONLY);
+		if (fd < 0)
+			return;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0) {
+			close(fd);
+			return;
+		}
+
+		if (info.st_size == 0) {
+			close(fd);
+			_data = EmptyFile;
+			return;
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd); // the mapping keeps the file alive
+		if (view == MAP_FAILED)
+			return;
+
+		// the reader walks the file front to back once
+		madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+		_data = static_cast<const char*>(view);
+		_size = static_cast<u64>(info.st_size);
+		_handle = view;
+	}
+
+	MappedPuzzleFile::~MappedPuzzleFile() {
+		if (_handle == nullptr)
+			return;
+
+		munmap(_handle, static_cast<size_t>(_size));
+	}
+#endif
+}
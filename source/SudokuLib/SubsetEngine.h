@@ -0,0 +1,187 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <span>
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuTypes.h>
+#include <BoardUtils.h>
+
+namespace ddahlkvist
+{
+	// Naked and hidden subsets [pairs, triplets, quads] are found on 9-bit masks local to one unit.
+	// A cell mask has bit c set for candidateId c, a digit mask has bit i set for position i of the unit [BoardBits::NodesOfUnit].
+	namespace subsets
+	{
+		constexpr uint MinSize = 2;
+		constexpr uint MaxSize = 4;
+
+		namespace tables {
+			constexpr uint binomial9(uint k) {
+				uint n = 1;
+				for (uint i = 0; i < k; ++i)
+					n = n * (9 - i) / (i + 1);
+				return n;
+			}
+
+			template<uint Size>
+			constexpr std::array<u16, binomial9(Size)> buildMasksWithBitCount() {
+				std::array<u16, binomial9(Size)> out{};
+				uint numMasks = 0;
+				for (uint mask = 0; mask < (1u << 9); ++mask) {
+					if (std::popcount(mask) == static_cast<int>(Size))
+						out[numMasks++] = static_cast<u16>(mask);
+				}
+				return out;
+			}
+		}
+
+		// every 9-bit mask with Size bits set in ascending order, so the masks only using the lowest n bits come first
+		template<uint Size>
+		inline constexpr auto MasksWithBitCount = tables::buildMasksWithBitCount<Size>();
+
+		inline std::span<const u16> masksWithBitCount(uint size) {
+			assert(size >= MinSize && size <= MaxSize);
+			switch (size) {
+			case 2: return MasksWithBitCount<2>;
+			case 3: return MasksWithBitCount<3>;
+			default: return MasksWithBitCount<4>;
+			}
+		}
+
+		// calls action(members) for every subset of size entries out of the first count entries, members has bit i set for entry i
+		template<typename SubsetAction>
+		void foreachSubsetOf(uint count, uint size, SubsetAction&& action) {
+			if (count < size)
+				return;
+
+			const uint end = 1u << count;
+			for (const u16 members : masksWithBitCount(size)) {
+				if (members >= end)
+					break;
+				action(members);
+			}
+		}
+
+		struct SubsetMatch {
+			u8 unitId;
+			u16 cells;			// positions in the unit
+			u16 candidates;		// candidateIds
+		};
+
+		// candidate masks of all nodes taken once up front, a technique can then modify nodes while it enumerates and still see the board it started from
+		struct BoardCandidates {
+			explicit BoardCandidates(const Board& b) {
+				for (uint i = 0; i < BoardSize; ++i)
+					cells[i] = static_cast<u16>(b.Nodes[i].getCandidates() >> 1);
+			}
+
+			// derived from per-candidate boards [CandidateState], candidateBoards[c] --> the nodes holding candidateId c
+			explicit BoardCandidates(const BoardBits::BitBoards9& candidateBoards) : cells{} {
+				for (uint c = 0; c < 9; ++c) {
+					candidateBoards[c].foreachSetBit([this, c](u32 nodeId) {
+						cells[nodeId] |= static_cast<u16>(1u << c);
+					});
+				}
+			}
+
+			u16 cells[BoardSize];	// candidateIds, 0 for solved nodes
+		};
+
+		inline u8 nodeIdsOf(const SubsetMatch& match, u8* outNodeIds) {
+			u8 numNodes = 0;
+			for (u32 position : SetBits<u16>(match.cells))
+				outNodeIds[numNodes++] = BoardBits::NodesOfUnit[match.unitId][position];
+			return numNodes;
+		}
+
+		// candidateIds --> Node::getCandidates layout
+		constexpr u16 toNodeMask(u16 candidateIds) { return static_cast<u16>(candidateIds << 1); }
+
+		// size nodes of a unit that only have size candidates between them, every other node in the unit can drop those candidates
+		template<typename MatchAction>
+		void foreachNakedSubset(const BoardCandidates& board, uint size, MatchAction&& action) {
+			for (uint unitId = 0; unitId < 27; ++unitId) {
+				// only nodes with [2, size] candidates can be part of the subset
+				u16 eligibleCandidates[9];
+				u8 eligiblePositions[9];
+				uint numEligible = 0;
+				for (uint position = 0; position < 9; ++position) {
+					const u16 candidates = board.cells[BoardBits::NodesOfUnit[unitId][position]];
+					const u32 numCandidates = popCount16(candidates);
+					if (numCandidates >= 2 && numCandidates <= size) {
+						eligibleCandidates[numEligible] = candidates;
+						eligiblePositions[numEligible++] = static_cast<u8>(position);
+					}
+				}
+
+				foreachSubsetOf(numEligible, size, [&](u16 members) {
+					u16 candidates = 0;
+					for (u32 i : SetBits<u16>(members))
+						candidates |= eligibleCandidates[i];
+					if (popCount16(candidates) > size)
+						return;
+
+					u16 cells = 0;
+					for (u32 i : SetBits<u16>(members))
+						cells |= static_cast<u16>(1u << eligiblePositions[i]);
+					action(SubsetMatch{ static_cast<u8>(unitId), cells, candidates });
+				});
+			}
+		}
+
+		// size candidates that only size nodes of a unit can hold, those nodes can drop all their other candidates
+		template<typename MatchAction>
+		void foreachHiddenSubset(const BoardCandidates& board, uint size, MatchAction&& action) {
+			for (uint unitId = 0; unitId < 27; ++unitId) {
+				u16 cellCandidates[9];
+				u16 digitCells[9] = {};
+				u16 unsolvedCells = 0;
+				for (uint position = 0; position < 9; ++position) {
+					const u16 candidates = board.cells[BoardBits::NodesOfUnit[unitId][position]];
+					cellCandidates[position] = candidates;
+					unsolvedCells |= static_cast<u16>((candidates != 0) << position);
+					for (u32 candidateId : SetBits<u16>(candidates))
+						digitCells[candidateId] |= static_cast<u16>(1u << position);
+				}
+
+				const u32 numUnsolved = popCount16(unsolvedCells);
+				if (numUnsolved <= size)
+					continue;
+
+				// only candidates held by [2, size] nodes can be part of the subset
+				u16 eligibleCells[9];
+				u8 eligibleCandidateIds[9];
+				uint numEligible = 0;
+				for (uint candidateId = 0; candidateId < 9; ++candidateId) {
+					const u32 numCells = popCount16(digitCells[candidateId]);
+					if (numCells >= 2 && numCells <= size) {
+						eligibleCells[numEligible] = digitCells[candidateId];
+						eligibleCandidateIds[numEligible++] = static_cast<u8>(candidateId);
+					}
+				}
+
+				foreachSubsetOf(numEligible, size, [&](u16 members) {
+					u16 cells = 0;
+					for (u32 i : SetBits<u16>(members))
+						cells |= eligibleCells[i];
+					const u32 numCells = popCount16(cells);
+					if (numCells < 2 || numCells > size)
+						return;
+
+					u16 candidates = 0;
+					for (u32 i : SetBits<u16>(members))
+						candidates |= static_cast<u16>(1u << eligibleCandidateIds[i]);
+
+					// only a match if the nodes have something else to drop
+					u16 cellsCandidates = 0;
+					for (u32 position : SetBits<u16>(cells))
+						cellsCandidates |= cellCandidates[position];
+					if (popCount16(cellsCandidates) > numCells)
+						action(SubsetMatch{ static_cast<u8>(unitId), cells, candidates });
+				});
+			}
+		}
+	}
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuGenerator.h>
+#include <SudokuLib/SudokuSolver.h>
+#include <BoardUtils.h>
+#include <WorkStealing.h>
+
+namespace ddahlkvist
+{
+	namespace
+	{
+		using Random = std::mt19937_64;
+
+		bool isWithinTarget(const Board& puzzle, Result& scratch, const GeneratorOptions& options) {
+			const bool anyDifficulty = options.minTechnique == Techniques::None && options.maxTechnique == Techniques::Backtracking;
+			if (anyDifficulty)
+				return true;
+
+			Board solved = puzzle;
+			scratch.reset();
+			scratch.ledger.numIterations = 0;
+			solveBoard(solved, scratch);
+
+			return isWithinDifficulty(hardestTechnique(scratch.ledger), options.minTechnique, options.maxTechnique);
+		}
+	}
+
+	Board generateFullGrid(u64 seed) {
+		Random random(seed);
+
+		// the three blocks on the diagonal do not see each other, so any permutation in each of them can be completed
+		char raw[BoardSize];
+		std::fill(std::begin(raw), std::end(raw), '.');
+
+		char digits[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+		for (uint blockId : { 0u, 4u, 8u }) {
+			std::shuffle(std::begin(digits), std::end(digits), random);
+
+			const u16 topLeft = topLeftFromblockId(blockId);
+			for (uint i = 0; i < 9; ++i)
+				raw[topLeft + (i / 3) * 9 + (i % 3)] = digits[i];
+		}
+
+		Board grid = Board::fromString(raw);
+		Result ignored;
+		const bool solved = solveBoardExactCover(grid, ignored);
+		assert(solved);
+		(void)solved;
+
+		return grid;
+	}
+
+	Board removeCluesMinimal(const Board& fullGrid, u64 seed) {
+		Random random(seed);
+
+		u8 order[BoardSize];
+		std::iota(std::begin(order), std::end(order), u8(0));
+		std::shuffle(std::begin(order), std::end(order), random);
+
+		// a clue that could not be removed stays required when more clues are removed later, so one pass gives a minimal puzzle
+		Board puzzle = fullGrid;
+		for (u8 nodeId : order) {
+			const Node clue = puzzle.Nodes[nodeId];
+			if (!clue.isSolved())
+				continue;
+
+			puzzle.Nodes[nodeId] = Node();
+			if (!hasUniqueSolution(puzzle))
+				puzzle.Nodes[nodeId] = clue;
+		}
+
+		return puzzle;
+	}
+
+	GeneratorStats generatePuzzles(std::span<Board> outBoards, const GeneratorOptions& options) {
+		const auto start = std::chrono::steady_clock::now();
+
+		const u32 numBoards = static_cast<u32>(outBoards.size());
+		const u32 numThreads = options.numThreads != 0 ? options.numThreads : std::max(std::thread::hardware_concurrency(), 1u);
+
+		// each worker owns its scratch result and counters, nothing is shared on the hot path
+		struct alignas(64) WorkerState {
+			Result scratch;
+			u32 numGenerated = 0;
+			u32 numAttempts = 0;
+		};
+		std::unique_ptr<WorkerState[]> workers(new WorkerState[numThreads]);
+
+		runWorkStealing(numBoards, numThreads, 1u, [&](u32 workerId, u32 boardIdx) {
+			WorkerState& worker = workers[workerId];
+			std::seed_seq sequence{ static_cast<u32>(options.seed), static_cast<u32>(options.seed >> 32), static_cast<u32>(boardIdx) };
+			Random random(sequence);
+
+			Board& out = outBoards[boardIdx];
+			out = Board{};
+
+			for (u32 attempt = 0; attempt < options.maxAttemptsPerPuzzle; ++attempt) {
+				worker.numAttempts++;
+
+				const Board grid = generateFullGrid(random());
+				const Board puzzle = removeCluesMinimal(grid, random());
+				if (isWithinTarget(puzzle, worker.scratch, options)) {
+					out = puzzle;
+					worker.numGenerated++;
+					return;
+				}
+			}
+		});
+
+		GeneratorStats stats;
+		for (u32 i = 0; i < numThreads; ++i) {
+			stats.numGenerated += workers[i].numGenerated;
+			stats.numAttempts += workers[i].numAttempts;
+		}
+
+		stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		stats.puzzlesPerSecond = stats.seconds > 0.0 ? stats.numGenerated / stats.seconds : 0.0;
+		return stats;
+	}
+}
@@ -34,6 +34,10 @@ namespace ddahlkvist
 			TechniqueName(Techniques::Y_Wing, "Y-Wing"),
 			TechniqueName(Techniques::SingleChain, "Single Chain"),
 			TechniqueName(Techniques::UniqueRectangle, "Unique Rectangle"),
+			TechniqueName(Techniques::Swordfish, "Swordfish"),
+			TechniqueName(Techniques::Jellyfish, "Jellyfish"),
+			TechniqueName(Techniques::FinnedFish, "Finned Fish"),
+			TechniqueName(Techniques::Backtracking, "Backtracking"),
 		};
 		return g_TechniqueNameLookup[technique];
 	}
@@ -41,14 +45,12 @@ namespace ddahlkvist
 
 
 	void validateNoDuplicates(const Board& b) {
-		BoardBits::BitBoards27 allDimensions;
 		BoardBits::BitBoards9 allSolved;
 		BitBoard solved;
-		BoardBits::AllDimensions(allDimensions);
 		BoardBits::fillBitsSolved(allSolved, solved, b);
 
 
-		for (auto dimension : allDimensions) {
+		for (auto dimension : BoardBits::Units) {
 			const BitBoard solvedNodes = (solved & dimension);
 			const u32 solvedNodeCount = solvedNodes.countSetBits();
 			const u32 solvedValues = countCandidates(BoardUtils::buildValueMaskFromSolvedNodes(b.Nodes, solvedNodes));
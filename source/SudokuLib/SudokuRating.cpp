@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuRating.h>
+#include <SudokuLib/SudokuSolver.h>
+#include <BoardUtils.h>
+#include <WorkStealing.h>
+
+namespace ddahlkvist
+{
+	RatingWeights RatingWeights::defaults() {
+		RatingWeights weights;
+
+		auto set = [&weights](Techniques technique, float perUse, float perNode) {
+			weights.perUse[static_cast<u32>(technique)] = perUse;
+			weights.perNode[static_cast<u32>(technique)] = perNode;
+		};
+
+		set(Techniques::None, 0.f, 0.f);
+		set(Techniques::NaiveCandidates, 0.f, 0.f); // bookkeeping, not a deduction a human would count
+		set(Techniques::NakedSingle, 1.f, 0.1f);
+		set(Techniques::HiddenSingle, 1.5f, 0.15f);
+		set(Techniques::NakedPair, 3.f, 0.3f);
+		set(Techniques::NakedTriplet, 4.f, 0.4f);
+		set(Techniques::HiddenPair, 4.f, 0.4f);
+		set(Techniques::HiddenTriplet, 5.f, 0.5f);
+		set(Techniques::NakedQuad, 6.f, 0.6f);
+		set(Techniques::HiddenQuad, 7.f, 0.7f);
+		set(Techniques::PointingPair, 2.5f, 0.25f);
+		set(Techniques::BoxLineReduction, 3.f, 0.3f);
+		set(Techniques::X_Wing, 8.f, 0.8f);
+		set(Techniques::Y_Wing, 9.f, 0.9f);
+		set(Techniques::SingleChain, 10.f, 1.f);
+		set(Techniques::UniqueRectangle, 10.f, 1.f);
+		set(Techniques::Swordfish, 11.f, 1.1f);
+		set(Techniques::Jellyfish, 13.f, 1.3f);
+		set(Techniques::FinnedFish, 14.f, 1.4f);
+		set(Techniques::Backtracking, 50.f, 1.f);
+
+		return weights;
+	}
+
+	BoardRating rateLedger(const SolveLedger& ledger, bool solved, const RatingWeights& weights) {
+		BoardRating rating;
+		rating.numIterations = ledger.numIterations;
+		rating.solved = solved;
+
+		for (u32 i = 0; i < ledger.numIterations; ++i) {
+			const u8 numChanged = ledger.numNodesChangedInIteration[i];
+			if (numChanged == 0)
+				continue;
+
+			const Techniques technique = ledger.techniqueUsedInIteration[i];
+			const u32 idx = static_cast<u32>(technique);
+			rating.score += weights.perUse[idx] + weights.perNode[idx] * numChanged;
+			rating.hardest = harderOf(rating.hardest, technique);
+		}
+
+		return rating;
+	}
+
+	BoardRating rateBoard(const Board& b, Result& scratch, const RatingWeights& weights) {
+		Board solved = b;
+		scratch.reset();
+		scratch.ledger.numIterations = 0;
+
+		const bool isSolved = solveBoard(solved, scratch);
+		return rateLedger(scratch.ledger, isSolved, weights);
+	}
+
+	RatingSummary rateBoards(std::span<const Board> boards, std::span<BoardRating> outRatings, const RatingOptions& options) {
+		assert(outRatings.size() == boards.size());
+
+		const u32 numBoards = static_cast<u32>(boards.size());
+		const u32 numThreads = options.numThreads != 0 ? options.numThreads : std::max(std::thread::hardware_concurrency(), 1u);
+
+		// each worker owns its scratch result and summary, they are only merged once all boards are rated
+		struct alignas(64) WorkerState {
+			Result scratch;
+			RatingSummary summary;
+		};
+		std::unique_ptr<WorkerState[]> workers(new WorkerState[numThreads]);
+
+		runWorkStealing(numBoards, numThreads, options.chunkSize, [&](u32 workerId, u32 boardIdx) {
+			WorkerState& worker = workers[workerId];
+			const BoardRating rating = rateBoard(boards[boardIdx], worker.scratch, options.weights);
+			outRatings[boardIdx] = rating;
+			worker.summary.add(rating);
+		});
+
+		RatingSummary summary;
+		for (u32 i = 0; i < numThreads; ++i)
+			summary.add(workers[i].summary);
+
+		return summary;
+	}
+}
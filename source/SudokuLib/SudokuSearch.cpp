@@ -0,0 +1,148 @@
+#include <bit>
+#include <cstring>
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuSolver.h>
+#include <BoardUtils.h>
+
+namespace ddahlkvist
+{
+	namespace
+	{
+		// every level of the search saves each node at most once, the root level is level 0
+		constexpr u32 MaxSearchDepth = BoardSize;
+		constexpr u32 MaxTrailEntries = BoardSize * (MaxSearchDepth + 1);
+
+		struct SearchFrame {
+			u32 trailMark;				// trail size before the guess was placed, undoing to it restores the board from before the guess
+			u16 untriedCandidates;
+			u8 nodeId;
+		};
+
+		// all storage is fixed size so a search never touches the heap
+		struct SearchState {
+			explicit SearchState(SudokuContext& context)
+				: p(context)
+			{
+				memcpy(shadow, p.b.Nodes, sizeof(Node) * BoardSize);
+			}
+
+			// push the value each changed node had at the start of the current level, unless it was already saved on this level
+			void record(const BitBoard& changedNodes) {
+				const BitBoard unsaved = changedNodes & savedInLevel.invert();
+				unsaved.foreachSetBit([this](u32 bit) {
+					assert(trailSize < MaxTrailEntries);
+					trail[trailSize++] = Change{ static_cast<u8>(bit), shadow[bit] };
+				});
+				savedInLevel |= changedNodes;
+
+				changedNodes.foreachSetBit([this](u32 bit) {
+					shadow[bit] = p.b.Nodes[bit];
+				});
+			}
+
+			void undoTo(u32 trailMark) {
+				BitBoard restored;
+				while (trailSize > trailMark) {
+					const Change& change = trail[--trailSize];
+					p.b.Nodes[change.index] = change.prev;
+					shadow[change.index] = change.prev;
+					restored.setBit(change.index);
+				}
+				savedInLevel = {};
+				updateContext(p, restored);
+				// peers got their candidates back without the solved nodes changing, queue them all for removeNaiveCandidates again
+				p.PendingSolved = p.Solved;
+			}
+
+			void beginLevel() {
+				savedInLevel = {};
+			}
+
+			SudokuContext& p;
+			Node shadow[BoardSize];		// board as of the last record, used to fetch the previous value of changed nodes
+			Change trail[MaxTrailEntries];
+			u32 trailSize = 0;
+			BitBoard savedInLevel;
+			SearchFrame frames[MaxSearchDepth];
+			u32 depth = 0;
+		};
+
+		// run the propagator until it stops making progress, returns false if the board ended up in a contradiction
+		bool propagateUntilStable(SearchState& s, PropagateFunction propagate) {
+			SudokuContext& p = s.p;
+
+			for (u32 i = 0; i < SolveLedger::MaxEntries; ++i) {
+				if (BoardBits::hasContradiction(p))
+					return false;
+				if (p.Unsolved == BitBoard{})
+					return true;
+
+				p.result.reset();
+				if (!propagate(p) || p.result.size() == 0)
+					return true;
+
+				const BitBoard changedNodes = p.result.changedNodes();
+				s.record(changedNodes);
+				updateContext(p, changedNodes);
+			}
+
+			return !BoardBits::hasContradiction(p);
+		}
+
+		// the unsolved node with the fewest candidates gives the smallest branching factor
+		u8 pickBranchNode(const SudokuContext& p) {
+			for (int maxCandidates = 1; maxCandidates < 9; ++maxCandidates) {
+				const BitBoard nodes = BoardBits::nodesWithCandidateCountBetweenXY(p.AllCandidates, 1, maxCandidates) & p.Unsolved;
+				if (nodes.notEmpty())
+					return nodes.firstOne();
+			}
+			return p.Unsolved.firstOne();
+		}
+
+		void placeGuess(SearchState& s, SearchFrame& frame) {
+			SudokuContext& p = s.p;
+
+			const u16 candidate = static_cast<u16>(frame.untriedCandidates & (~frame.untriedCandidates + 1u));
+			frame.untriedCandidates ^= candidate;
+
+			BitBoard guessedNode;
+			guessedNode.setBit(frame.nodeId);
+
+			s.beginLevel();
+			p.b.Nodes[frame.nodeId].solve(static_cast<u32>(std::countr_zero(candidate)));
+			s.record(guessedNode);
+			updateContext(p, guessedNode);
+		}
+	}
+
+	bool searchBoard(SudokuContext& p, PropagateFunction propagate) {
+		SearchState s(p);
+
+		bool consistent = propagateUntilStable(s, propagate);
+		while (true) {
+			if (consistent) {
+				if (p.Unsolved == BitBoard{})
+					return true;
+
+				assert(s.depth < MaxSearchDepth);
+				const u8 nodeId = pickBranchNode(p);
+				s.frames[s.depth++] = SearchFrame{ s.trailSize, p.b.Nodes[nodeId].getCandidates(), nodeId };
+			}
+			else {
+				while (s.depth > 0 && s.frames[s.depth - 1].untriedCandidates == 0)
+					s.depth--;
+
+				if (s.depth == 0) {
+					s.undoTo(0);
+					return false;
+				}
+
+				s.undoTo(s.frames[s.depth - 1].trailMark);
+			}
+
+			placeGuess(s, s.frames[s.depth - 1]);
+			consistent = propagateUntilStable(s, propagate);
+		}
+	}
+}
@@ -0,0 +1,152 @@
+#include <memory>
+#include <thread>
+
+#include <SudokuLib/sudokulib_module.h>
+#include <SudokuLib/SudokuSolver.h>
+#include <BoardUtils.h>
+#include <CandidateState.h>
+#include <ExactCover.h>
+#include <WorkStealing.h>
+
+namespace ddahlkvist
+{
+	bool solveBoard(Board& b, Result& r) {
+		return solveBoardWithPipeline<techniques::DefaultPipeline>(b, r);
+	}
+
+	namespace
+	{
+		// one solver per thread, restored with clearGivens after every use so the matrix is only copied once
+		ExactCoverSolver& threadExactCoverSolver() {
+			thread_local ExactCoverSolver solver;
+			return solver;
+		}
+	}
+
+	bool solveBoardExactCover(Board& b, Result& r) {
+		r.reset();
+		r.ledger.numIterations = 0;
+
+		ExactCoverSolver& solver = threadExactCoverSolver();
+		const bool solved = solver.loadGivens(b) && solver.search(1) == 1;
+		if (solved)
+			solver.writeSolution(b);
+
+		solver.clearGivens();
+		return solved;
+	}
+
+	bool solveBoardCandidateMajor(Board& b, Result& r) {
+		r.reset();
+		r.ledger.numIterations = 0;
+
+		CandidateState state;
+		if (!CandidateState::fromBoard(b, state) || !solveCandidateState(state))
+			return false;
+
+		state.writeToBoard(b);
+		return true;
+	}
+
+	u32 countSolutions(const Board& b, u32 limit) {
+		ExactCoverSolver& solver = threadExactCoverSolver();
+		const u32 numSolutions = solver.loadGivens(b) ? solver.search(limit) : 0u;
+
+		solver.clearGivens();
+		return numSolutions;
+	}
+
+	bool hasUniqueSolution(const Board& b) {
+		return countSolutions(b, 2) == 1;
+	}
+
+	bool solveBoard(Board& b, Result& r, SolveMode mode) {
+		switch (mode) {
+		case SolveMode::RawThroughput:
+			return solveBoardExactCover(b, r);
+		case SolveMode::CandidateMajor:
+			return solveBoardCandidateMajor(b, r);
+		case SolveMode::Explainable:
+		default:
+			return solveBoard(b, r);
+		}
+	}
+
+	Techniques hardestTechnique(const SolveLedger& ledger) {
+		Techniques hardest = Techniques::None;
+		for (u32 i = 0; i < ledger.numIterations; ++i) {
+			if (ledger.numNodesChangedInIteration[i] > 0)
+				hardest = harderOf(hardest, ledger.techniqueUsedInIteration[i]);
+		}
+		return hardest;
+	}
+
+	BatchOutcome solveBatch(std::span<Board> boards, const BatchOptions& options, std::span<Result> results) {
+		assert(results.empty() || results.size() == boards.size());
+
+		const u32 numBoards = static_cast<u32>(boards.size());
+		const u32 numThreads = options.numThreads != 0 ? options.numThreads : std::max(std::thread::hardware_concurrency(), 1u);
+		const bool useScratch = results.empty();
+
+		// each worker owns its scratch result and solved counter, nothing is shared on the hot path
+		struct alignas(64) WorkerState {
+			Result scratch;
+			u32 numSolved = 0;
+		};
+		std::unique_ptr<WorkerState[]> workers(new WorkerState[numThreads]);
+
+		runWorkStealing(numBoards, numThreads, options.chunkSize, [&](u32 workerId, u32 boardIdx) {
+			WorkerState& worker = workers[workerId];
+			Result& r = useScratch ? worker.scratch : results[boardIdx];
+			r.reset();
+			r.ledger.numIterations = 0;
+
+			worker.numSolved += solveBoard(boards[boardIdx], r, options.mode);
+		});
+
+		BatchOutcome outcome;
+		outcome.numBoards = numBoards;
+		for (u32 i = 0; i < numThreads; ++i)
+			outcome.numSolved += workers[i].numSolved;
+
+		return outcome;
+	}
+
+	BatchOutcome solveBatch(const BoardBatch& batch, std::span<PackedBoard> solutions, const BatchOptions& options) {
+		assert(solutions.empty() || solutions.size() == batch.size());
+
+		const u32 numBoards = batch.size();
+		const u32 numThreads = options.numThreads != 0 ? options.numThreads : std::max(std::thread::hardware_concurrency(), 1u);
+
+		struct alignas(64) WorkerState {
+			Board board;
+			Result scratch;
+			u32 numSolved = 0;
+		};
+		std::unique_ptr<WorkerState[]> workers(new WorkerState[numThreads]);
+
+		runWorkStealing(numBoards, numThreads, options.chunkSize, [&](u32 workerId, u32 boardIdx) {
+			WorkerState& worker = workers[workerId];
+			worker.scratch.reset();
+			worker.scratch.ledger.numIterations = 0;
+
+			// a view built straight from a span is not validated up front, corrupt boards count as unsolved
+			if (!unpackBoard(batch[boardIdx], worker.board)) {
+				if (!solutions.empty())
+					solutions[boardIdx] = PackedBoard{};
+				return;
+			}
+			worker.numSolved += solveBoard(worker.board, worker.scratch, options.mode);
+
+			if (!solutions.empty())
+				solutions[boardIdx] = packBoard(worker.board);
+		});
+
+		BatchOutcome outcome;
+		outcome.numBoards = numBoards;
+		for (u32 i = 0; i < numThreads; ++i)
+			outcome.numSolved += workers[i].numSolved;
+
+		return outcome;
+	}
+}
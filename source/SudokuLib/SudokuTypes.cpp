@@ -1,19 +1,164 @@
+#include <immintrin.h>
+
 #include <SudokuLib/sudokulib_module.h>
 #include <SudokuLib/SudokuTypes.h>
 #include <BoardUtils.h>
+#include <BitKernels.h>
 
 namespace ddahlkvist
 {
+	namespace
+	{
+		// bit i of a mask is set when character i of the board belongs to that class, [0] holds nodes 0-63 and [1] nodes 64-80
+		struct CharClasses
+		{
+			u64 digits[2] = {};
+			u64 empty[2] = {};
+			u64 values[9][2] = {};
+		};
+
+		inline void addMask(u64* words, u32 firstNode, u64 mask) {
+			words[firstNode / 64] |= mask << (firstNode % 64);
+		}
+
+		template<bool WithValues>
+		inline void classifyChunk16(const char* data, u32 firstNode, CharClasses& out) {
+			const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + firstNode));
+			auto movemask = [](__m128i mask) -> u64 { return static_cast<u16>(_mm_movemask_epi8(mask)); };
+
+			// signed compares, bytes above 0x7f are negative and never a digit
+			const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0')), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+			const __m128i isEmpty = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('.')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('0'))),
+				_mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('x')), _mm_cmpeq_epi8(chars, _mm_set1_epi8(' '))));
+			addMask(out.digits, firstNode, movemask(isDigit));
+			addMask(out.empty, firstNode, movemask(isEmpty));
+
+			if constexpr (WithValues) {
+				for (u32 d = 0; d < 9; ++d)
+					addMask(out.values[d], firstNode, movemask(_mm_cmpeq_epi8(chars, _mm_set1_epi8(static_cast<char>('1' + d)))));
+			}
+		}
+
+		// the first 64 nodes in two loads, only called when the cpu has avx2 [BitKernelLevel::Avx2]
+		template<bool WithValues>
+		DD_TARGET_AVX2 void classifyFirst64Avx2(const char* data, CharClasses& out) {
+			for (u32 word = 0; word < 2; ++word) {
+				const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + word * 32));
+
+				const __m256i isDigit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0')), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+				const __m256i isEmpty = _mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('.')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('0'))),
+					_mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('x')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' '))));
+				// movemask returns an int, it must not be sign extended into the upper half of the word
+				addMask(out.digits, word * 32, static_cast<unsigned int>(_mm256_movemask_epi8(isDigit)));
+				addMask(out.empty, word * 32, static_cast<unsigned int>(_mm256_movemask_epi8(isEmpty)));
+
+				if constexpr (WithValues) {
+					for (u32 d = 0; d < 9; ++d) {
+						const __m256i isValue = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(static_cast<char>('1' + d)));
+						addMask(out.values[d], word * 32, static_cast<unsigned int>(_mm256_movemask_epi8(isValue)));
+					}
+				}
+			}
+		}
+
+		template<bool WithValues>
+		void classifyBoard(const char* data, CharClasses& out) {
+			// picked at runtime like the bit kernels, the default build only targets sse2
+			if (bitKernels().level >= BitKernelLevel::Avx2) {
+				classifyFirst64Avx2<WithValues>(data, out);
+			}
+			else {
+				for (u32 firstNode = 0; firstNode < 64; firstNode += 16)
+					classifyChunk16<WithValues>(data, firstNode, out);
+			}
+			classifyChunk16<WithValues>(data, 64, out);
+
+			// the last node on its own to never read past the 81 characters
+			const u32 lastNode = BoardSize - 1;
+			const char last = data[lastNode];
+			const bool lastIsDigit = last >= '1' && last <= '9';
+			const bool lastIsEmpty = last == '.' || last == '0' || last == 'x' || last == ' ';
+			addMask(out.digits, lastNode, lastIsDigit);
+			addMask(out.empty, lastNode, lastIsEmpty);
+			if constexpr (WithValues) {
+				if (lastIsDigit)
+					addMask(out.values[last - '1'], lastNode, 1);
+			}
+		}
+
+		bool isWellFormed(const CharClasses& classes) {
+			const BitBoard wellFormed = BitBoard(classes.digits[0], classes.digits[1]) | BitBoard(classes.empty[0], classes.empty[1]);
+			return wellFormed == BitBoard(BitBoard::All{});
+		}
+
+		// only the given nodes are visited, their value is read straight from the character
+		void fillNodes(Board& b, const char* data, const CharClasses& classes) {
+			std::fill(std::begin(b.Nodes), std::end(b.Nodes), Node());
+			for (u32 word = 0; word < 2; ++word) {
+				u64 givens = classes.digits[word];
+				while (givens != 0) {
+					const u32 nodeId = word * 64 + trailingZeros64(givens);
+					givens = clearLowestSetBit(givens);
+					b.Nodes[nodeId].solve(static_cast<u32>(data[nodeId] - '0'));
+				}
+			}
+		}
+	}
+
+	bool parseBoardMasks(const char* data, ParsedBoardMasks& outMasks) {
+		CharClasses classes;
+		classifyBoard<true>(data, classes);
+
+		outMasks.solved = BitBoard(classes.digits[0], classes.digits[1]);
+		for (u32 d = 0; d < 9; ++d)
+			outMasks.values[d] = BitBoard(classes.values[d][0], classes.values[d][1]);
+
+		const BitBoard wellFormed = outMasks.solved | BitBoard(classes.empty[0], classes.empty[1]);
+		outMasks.malformed = wellFormed.invert();
+		return !outMasks.malformed.notEmpty();
+	}
+
+	Board Board::fromString(const char* data) {
+		CharClasses classes;
+		classifyBoard<false>(data, classes);
+
+		Board b;
+		fillNodes(b, data, classes);
+		return b;
+	}
+
+	bool Board::tryFromString(const char* data, Board& outBoard) {
+		CharClasses classes;
+		classifyBoard<false>(data, classes);
+		if (!isWellFormed(classes))
+			return false;
+
+		fillNodes(outBoard, data, classes);
+		return true;
+	}
+
 	SudokuContext buildContext(Board& b, Result& r) 
 	{
-		SudokuContext ctx{ b, r };
+		SudokuContext ctx{ b, r, BoardBits::Units };
 
 		BoardBits::fillBitsSolved(ctx.SolvedValues, ctx.Solved, b);
 		ctx.Unsolved = ctx.Solved.invert();
+		ctx.PendingSolved = ctx.Solved;
 		BoardBits::buildCandidateBoards(ctx.AllCandidates, ctx.Unsolved, b);
-		BoardBits::AllDimensions(ctx.AllDimensions);
 
 		return ctx;
 	}
 
+	void updateContext(SudokuContext& ctx, const BitBoard& changedNodes)
+	{
+		if (!changedNodes.notEmpty())
+			return;
+
+		BoardBits::refreshBitsForNodes(ctx.SolvedValues, ctx.AllCandidates, ctx.Solved, changedNodes, ctx.b);
+		ctx.Unsolved = ctx.Solved.invert();
+		ctx.PendingSolved = (ctx.PendingSolved | changedNodes) & ctx.Solved;
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <WorkStealing.h>
+
+namespace ddahlkvist
+{
+	namespace
+	{
+		thread_local bool t_insidePoolJob = false;
+	}
+
+	WorkerPool& WorkerPool::shared() {
+		// never destroyed, idle workers stay blocked on _wake until the process ends [joining them from a static destructor can deadlock during dll unload]
+		static WorkerPool* pool = new WorkerPool();
+		return *pool;
+	}
+
+	void WorkerPool::run(u32 numWorkers, const Job& job) {
+		if (numWorkers <= 1 || t_insidePoolJob) {
+			job(0);
+			return;
+		}
+
+		std::lock_guard<std::mutex> runLock(_runMutex);
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			// new workers start on the previous generation so they pick up this run
+			while (_threads.size() < numWorkers - 1)
+				_threads.emplace_back(&WorkerPool::workerMain, this, static_cast<u32>(_threads.size() + 1), _generation);
+
+			_job = &job;
+			_numWorkers = numWorkers;
+			_numPending = numWorkers - 1;
+			_generation++;
+		}
+		_wake.notify_all();
+
+		t_insidePoolJob = true;
+		job(0);
+		t_insidePoolJob = false;
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		_done.wait(lock, [this] { return _numPending == 0; });
+		_job = nullptr;
+	}
+
+	void WorkerPool::workerMain(u32 workerId, u64 generation) {
+		t_insidePoolJob = true;
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (true) {
+			_wake.wait(lock, [this, generation] { return _generation != generation; });
+			generation = _generation;
+			if (workerId >= _numWorkers)
+				continue;
+
+			const Job* job = _job;
+			lock.unlock();
+			(*job)(workerId);
+			lock.lock();
+
+			if (--_numPending == 0)
+				_done.notify_one();
+		}
+	}
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Core/Types.h>
+
+namespace ddahlkvist
+{
+	// Worker threads kept alive between batches, created on first use and grown to the largest number of workers asked for.
+	// run() hands the same job to workers [0, numWorkers), the calling thread is worker 0 and run() returns once every worker is done.
+	class WorkerPool
+	{
+	public:
+		using Job = std::function<void(u32 workerId)>;
+
+		static WorkerPool& shared();
+
+		// one run at a time, a run started from inside a job only executes job(0) on the calling thread [runWorkStealing then steals the other ranges itself]
+		void run(u32 numWorkers, const Job& job);
+
+	private:
+		WorkerPool() = default;
+		void workerMain(u32 workerId, u64 generation);
+
+		std::mutex _runMutex;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+		std::vector<std::thread> _threads;	// _threads[i] is worker i+1
+		const Job* _job = nullptr;
+		u64 _generation = 0;
+		u32 _numWorkers = 0;
+		u32 _numPending = 0;
+	};
+
+	// A range of indices [begin, end) owned by one worker, packed into a single u64 so that both the owner and thieves can update it with one CAS.
+	// The owner takes chunks from the front, a thief takes the back half. No locks are involved.
+	struct alignas(64) StealableRange
+	{
+		static constexpr u64 pack(u32 begin, u32 end) { return (static_cast<u64>(end) << 32) | begin; }
+		static constexpr u32 beginOf(u64 range) { return static_cast<u32>(range & 0xFFFFFFFFULL); }
+		static constexpr u32 endOf(u64 range) { return static_cast<u32>(range >> 32); }
+
+		void assign(u32 begin, u32 end) {
+			_range.store(pack(begin, end), std::memory_order_release);
+		}
+
+		bool popFront(u32 chunkSize, u32& outBegin, u32& outEnd) {
+			u64 current = _range.load(std::memory_order_acquire);
+			while (true) {
+				const u32 begin = beginOf(current);
+				const u32 end = endOf(current);
+				if (begin >= end)
+					return false;
+
+				const u32 claimedEnd = std::min(end, begin + chunkSize);
+				if (_range.compare_exchange_weak(current, pack(claimedEnd, end), std::memory_order_acq_rel)) {
+					outBegin = begin;
+					outEnd = claimedEnd;
+					return true;
+				}
+			}
+		}
+
+		bool stealHalf(u32& outBegin, u32& outEnd) {
+			u64 current = _range.load(std::memory_order_acquire);
+			while (true) {
+				const u32 begin = beginOf(current);
+				const u32 end = endOf(current);
+				if (begin >= end)
+					return false;
+
+				const u32 middle = begin + (end - begin) / 2;
+				if (_range.compare_exchange_weak(current, pack(begin, middle), std::memory_order_acq_rel)) {
+					outBegin = middle;
+					outEnd = end;
+					return true;
+				}
+			}
+		}
+
+	private:
+		std::atomic<u64> _range{ 0 };
+	};
+
+	// Splits [0, count) evenly over the workers and lets them steal from each other when their own range runs dry.
+	// The calling thread acts as worker 0, work(workerId, index) is invoked exactly once for every index, the other workers come from WorkerPool::shared().
+	template<typename WorkAction>
+	void runWorkStealing(u32 count, u32 numWorkers, u32 chunkSize, WorkAction&& work) {
+		if (count == 0)
+			return;
+
+		chunkSize = std::max<u32>(chunkSize, 1u);
+		numWorkers = std::clamp<u32>(numWorkers, 1u, (count + chunkSize - 1) / chunkSize);
+
+		std::unique_ptr<StealableRange[]> ranges(new StealableRange[numWorkers]);
+		for (u32 i = 0; i < numWorkers; ++i) {
+			const u32 begin = static_cast<u32>((static_cast<u64>(count) * i) / numWorkers);
+			const u32 end = static_cast<u32>((static_cast<u64>(count) * (i + 1)) / numWorkers);
+			ranges[i].assign(begin, end);
+		}
+
+		auto workerLoop = [&ranges, numWorkers, chunkSize, &work](u32 workerId) {
+			StealableRange& own = ranges[workerId];
+			u32 begin;
+			u32 end;
+
+			while (true) {
+				while (own.popFront(chunkSize, begin, end)) {
+					for (u32 i = begin; i < end; ++i)
+						work(workerId, i);
+				}
+
+				// own range is empty, nobody else will refill it, so it is safe to store stolen work there
+				bool stole = false;
+				for (u32 offset = 1; offset < numWorkers && !stole; ++offset) {
+					StealableRange& victim = ranges[(workerId + offset) % numWorkers];
+					stole = victim.stealHalf(begin, end);
+				}
+
+				if (!stole)
+					return; // everyone is empty, remaining in-flight work is owned by workers that are still running
+
+				own.assign(begin, end);
+			}
+		};
+
+		WorkerPool::shared().run(numWorkers, workerLoop);
+	}
+}